@@ -0,0 +1,403 @@
+
+
+#include "animation.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Internal Functions --
+
+static animation_t * animation_create(uint32_t width, uint32_t height, const console_cell_t *first_frame);
+static bool animation_add_frame(animation_t *animation, const console_cell_t *previous, const console_cell_t *cells);
+static bool animation_finish(animation_t *animation, const console_cell_t *last);
+static bool animation_append_deltas(animation_t *animation, const console_cell_t *from, const console_cell_t *to);
+static void animation_apply_frame(const animation_t *animation, uint32_t frame, console_cell_t *cells);
+
+
+// External Interface --
+
+animation_t * animation_from_views(console_view_t **views, uint32_t count) {
+    if (count == 0) {
+        return NULL;
+    }
+
+    animation_t *animation = animation_create(views[0]->width, views[0]->height, views[0]->cells);
+    if (animation == NULL) {
+        return NULL;
+    }
+    for (uint32_t i = 1; i < count; i++) {
+        if (views[i]->width != animation->width || views[i]->height != animation->height ||
+            !animation_add_frame(animation, views[i - 1]->cells, views[i]->cells)) {
+            animation_destroy(animation);
+            return NULL;
+        }
+    }
+
+    if (!animation_finish(animation, views[count - 1]->cells)) {
+        animation_destroy(animation);
+        return NULL;
+    }
+    return animation;
+}
+
+animation_t * animation_from_rexfile(const char *filename) {
+    console_layered_view_t *layered = console_layered_view_from_rexfile(filename);
+    if (layered == NULL) {
+        return NULL;
+    }
+
+    size_t cells_size = (size_t)layered->width * layered->height * sizeof(console_cell_t);
+    console_cell_t *previous = malloc(cells_size);
+    console_cell_t *cells = malloc(cells_size);
+    animation_t *animation = NULL;
+    if (previous == NULL || cells == NULL) {
+        goto done;
+    }
+
+    console_rect_t rect = {0, 0, layered->width, layered->height};
+    for (uint32_t l = 0; l < layered->layer_count; l++) {
+        console_layered_view_composite_rect(layered, 1u << l, rect, cells);
+        bool added = (l == 0)
+            ? (animation = animation_create(layered->width, layered->height, cells)) != NULL
+            : animation_add_frame(animation, previous, cells);
+        if (!added) {
+            goto fail;
+        }
+
+        console_cell_t *swap = previous;
+        previous = cells;
+        cells = swap;
+    }
+    if (!animation_finish(animation, previous)) {
+        goto fail;
+    }
+    goto done;
+
+fail:
+    if (animation != NULL) {
+        animation_destroy(animation);
+        animation = NULL;
+    }
+
+done:
+    free(cells);
+    free(previous);
+    console_layered_view_destroy(layered);
+    return animation;
+}
+
+animation_t * animation_from_rexfiles(const char **filenames, uint32_t count) {
+    if (count == 0) {
+        return NULL;
+    }
+
+    console_view_t *previous = console_view_from_rexfile(filenames[0]);
+    if (previous == NULL) {
+        return NULL;
+    }
+    animation_t *animation = animation_create(previous->width, previous->height, previous->cells);
+    if (animation == NULL) {
+        console_view_destroy(previous);
+        return NULL;
+    }
+
+    for (uint32_t i = 1; i < count; i++) {
+        console_view_t *view = console_view_from_rexfile(filenames[i]);
+        bool added = (view != NULL) && view->width == animation->width && view->height == animation->height &&
+                     animation_add_frame(animation, previous->cells, view->cells);
+        console_view_destroy(previous);
+        previous = view;
+        if (!added) {
+            goto fail;
+        }
+    }
+
+    if (!animation_finish(animation, previous->cells)) {
+        goto fail;
+    }
+    console_view_destroy(previous);
+    return animation;
+
+fail:
+    if (previous != NULL) {
+        console_view_destroy(previous);
+    }
+    animation_destroy(animation);
+    return NULL;
+}
+
+void animation_destroy(animation_t *animation) {
+    free(animation->deltas);
+    free(animation->frames);
+    free(animation->base_cells);
+    free(animation);
+}
+
+size_t animation_memory_size(const animation_t *animation) {
+    return ((size_t)animation->width * animation->height * sizeof(console_cell_t)) +
+           ((size_t)animation->frame_count * sizeof(animation_frame_t)) +
+           ((size_t)animation->delta_count * sizeof(animation_delta_t));
+}
+
+animation_player_t * animation_player_create(const animation_t *animation) {
+    size_t cells_size = (size_t)animation->width * animation->height * sizeof(console_cell_t);
+    console_cell_t *cells = malloc(cells_size);
+    if (cells == NULL) {
+        return NULL;
+    }
+    memcpy(cells, animation->base_cells, cells_size);
+
+    console_view_t *view = calloc(1, sizeof(console_view_t));
+    view->width = animation->width;
+    view->height = animation->height;
+    view->cells = cells;
+
+    animation_player_t *player = calloc(1, sizeof(animation_player_t));
+    player->animation = animation;
+    player->frame = 0;
+    player->view = view;
+
+    return player;
+}
+
+void animation_player_destroy(animation_player_t *player) {
+    console_view_destroy(player->view);
+    free(player);
+}
+
+uint32_t animation_player_advance(animation_player_t *player) {
+    const animation_t *animation = player->animation;
+    animation_apply_frame(animation, player->frame, player->view->cells);
+    uint32_t changed = animation->frames[player->frame].delta_count;
+    player->frame = (player->frame + 1) % animation->frame_count;
+    if (changed > 0) {
+        console_view_touch(player->view);
+    }
+
+    return changed;
+}
+
+void animation_player_seek(animation_player_t *player, uint32_t frame) {
+    const animation_t *animation = player->animation;
+    frame %= animation->frame_count;
+
+    // Replaying forward from frame 0 beats looping round from a later frame
+    if (frame < player->frame) {
+        memcpy(player->view->cells, animation->base_cells,
+                (size_t)animation->width * animation->height * sizeof(console_cell_t));
+        player->frame = 0;
+    }
+    while (player->frame != frame) {
+        animation_apply_frame(animation, player->frame, player->view->cells);
+        player->frame += 1;
+    }
+    console_view_touch(player->view);
+}
+
+
+// Internal Functions --
+
+static
+animation_t * animation_create(uint32_t width, uint32_t height, const console_cell_t *first_frame) {
+    size_t cells_size = (size_t)width * height * sizeof(console_cell_t);
+    console_cell_t *base_cells = malloc(cells_size);
+    if (base_cells == NULL) {
+        return NULL;
+    }
+    memcpy(base_cells, first_frame, cells_size);
+
+    animation_t *animation = calloc(1, sizeof(animation_t));
+    animation->width = width;
+    animation->height = height;
+    animation->frame_count = 1;
+    animation->base_cells = base_cells;
+    animation->frames = calloc(1, sizeof(animation_frame_t));
+
+    return animation;
+}
+
+/*
+ * Append a frame, storing the cells that differ from the previous frame.
+ */
+static
+bool animation_add_frame(animation_t *animation, const console_cell_t *previous, const console_cell_t *cells) {
+    animation_frame_t *frames = realloc(animation->frames, (animation->frame_count + 1) * sizeof(animation_frame_t));
+    if (frames == NULL) {
+        return false;
+    }
+    animation->frames = frames;
+
+    animation_frame_t *frame = &animation->frames[animation->frame_count - 1];
+    frame->first_delta = animation->delta_count;
+    bool ok = animation_append_deltas(animation, previous, cells);
+    frame->delta_count = animation->delta_count - frame->first_delta;
+
+    animation->frames[animation->frame_count] = (animation_frame_t){ animation->delta_count, 0 };
+    animation->frame_count += 1;
+
+    return ok;
+}
+
+/*
+ * Add the deltas leading from the last frame back to frame 0, and release spare capacity.
+ */
+static
+bool animation_finish(animation_t *animation, const console_cell_t *last) {
+    animation_frame_t *frame = &animation->frames[animation->frame_count - 1];
+    frame->first_delta = animation->delta_count;
+    bool ok = animation_append_deltas(animation, last, animation->base_cells);
+    frame->delta_count = animation->delta_count - frame->first_delta;
+
+    if (ok && animation->delta_count > 0 && animation->delta_count < animation->delta_capacity) {
+        animation_delta_t *deltas = realloc(animation->deltas, animation->delta_count * sizeof(animation_delta_t));
+        if (deltas != NULL) {
+            animation->deltas = deltas;
+            animation->delta_capacity = animation->delta_count;
+        }
+    }
+    return ok;
+}
+
+static
+bool animation_append_deltas(animation_t *animation, const console_cell_t *from, const console_cell_t *to) {
+    uint32_t cell_count = animation->width * animation->height;
+    for (uint32_t i = 0; i < cell_count; i++) {
+        if (memcmp(&from[i], &to[i], sizeof(console_cell_t)) == 0) {
+            continue;
+        }
+
+        if (animation->delta_count == animation->delta_capacity) {
+            uint32_t capacity = (animation->delta_capacity > 0) ? animation->delta_capacity * 2 : 256;
+            animation_delta_t *deltas = realloc(animation->deltas, capacity * sizeof(animation_delta_t));
+            if (deltas == NULL) {
+                return false;
+            }
+            animation->deltas = deltas;
+            animation->delta_capacity = capacity;
+        }
+        animation->deltas[animation->delta_count] = (animation_delta_t){ i, to[i] };
+        animation->delta_count += 1;
+    }
+    return true;
+}
+
+/*
+ * Turn frame into the frame after it, in place.
+ */
+static
+void animation_apply_frame(const animation_t *animation, uint32_t frame, console_cell_t *cells) {
+    const animation_frame_t *info = &animation->frames[frame];
+    if (info->delta_count == 0) { return; }
+
+    const animation_delta_t *delta = &animation->deltas[info->first_delta];
+    for (uint32_t d = 0; d < info->delta_count; d++, delta++) {
+        cells[delta->cell_index] = delta->cell;
+    }
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include "rex_export.h"
+
+#define TEST_WIDTH      60
+#define TEST_HEIGHT     40
+#define TEST_FRAMES     120
+
+/*
+ * A sprite with a static background, a glyph walking across it and a flickering torch.
+ */
+static
+void draw_test_frame(console_view_t *view, uint32_t frame) {
+    for (uint32_t y = 0; y < view->height; y++) {
+        for (uint32_t x = 0; x < view->width; x++) {
+            view->cells[(y * view->width) + x] = (console_cell_t){ '.' + (x * y) % 3,
+                COLOR_FROM_RGBA(40, 90, 40, 255), COLOR_FROM_RGBA(0, 0, (x + y) % 16, 255) };
+        }
+    }
+    for (uint32_t i = 0; i < 4; i++) {
+        uint32_t x = (frame + i) % view->width, y = 10 + i;
+        view->cells[(y * view->width) + x] = (console_cell_t){ '@', COLOR_FROM_RGBA(255, 255, 0, 255), COLOR_FROM_RGBA(0, 0, 0, 255) };
+    }
+    view->cells[(3 * view->width) + 3].fg_color = COLOR_FROM_RGBA(255, (frame * 37) % 256, 0, 255);
+}
+
+static
+bool player_matches(animation_player_t *player, console_view_t **views) {
+    return memcmp(player->view->cells, views[player->frame]->cells, TEST_WIDTH * TEST_HEIGHT * sizeof(console_cell_t)) == 0;
+}
+
+int main() {
+    console_view_t *views[TEST_FRAMES];
+    for (uint32_t f = 0; f < TEST_FRAMES; f++) {
+        views[f] = calloc(1, sizeof(console_view_t));
+        views[f]->width = TEST_WIDTH;
+        views[f]->height = TEST_HEIGHT;
+        views[f]->cells = malloc(TEST_WIDTH * TEST_HEIGHT * sizeof(console_cell_t));
+        draw_test_frame(views[f], f);
+    }
+
+    animation_t *animation = animation_from_views(views, TEST_FRAMES);
+    size_t full_size = (size_t)TEST_FRAMES * TEST_WIDTH * TEST_HEIGHT * sizeof(console_cell_t);
+    printf("%u frames: %zu bytes as views, %zu as an animation (%.1fx smaller)\n", TEST_FRAMES,
+            full_size, animation_memory_size(animation), (double)full_size / animation_memory_size(animation));
+
+    // Play twice through, so the wrap back to frame 0 is checked too
+    animation_player_t *player = animation_player_create(animation);
+    bool playback_ok = player_matches(player, views);
+    uint32_t most_changed = 0;
+    for (uint32_t step = 0; step < TEST_FRAMES * 2; step++) {
+        uint32_t changed = animation_player_advance(player);
+        if (changed > most_changed) { most_changed = changed; }
+        playback_ok = playback_ok && player_matches(player, views);
+    }
+    printf("Playback matches source frames: %s (at most %u cells changed per advance)\n",
+            playback_ok ? "yes" : "NO", most_changed);
+
+    animation_player_seek(player, 77);
+    bool seek_ok = player->frame == 77 && player_matches(player, views);
+    animation_player_seek(player, 5);
+    seek_ok = seek_ok && player->frame == 5 && player_matches(player, views);
+    printf("Seeking: %s\n", seek_ok ? "ok" : "WRONG");
+    animation_player_destroy(player);
+    animation_destroy(animation);
+
+    // The same frames as a file sequence
+    const char *filenames[TEST_FRAMES];
+    char names[TEST_FRAMES][64];
+    rex_tile_t *tiles = malloc(TEST_WIDTH * TEST_HEIGHT * sizeof(rex_tile_t));
+    rex_tile_layer_t layer = { TEST_WIDTH, TEST_HEIGHT, tiles };
+    rex_tile_map_t map = { (uint32_t)-1, 1, TEST_WIDTH, TEST_HEIGHT, &layer };
+    for (uint32_t f = 0; f < TEST_FRAMES; f++) {
+        snprintf(names[f], sizeof(names[f]), "/tmp/animation_test_%03u.xp", f);
+        filenames[f] = names[f];
+        rex_export_cells_to_tiles(views[f]->cells, TEST_WIDTH, TEST_HEIGHT, tiles);
+        rex_save_tile_map(&map, names[f], 1);
+    }
+    free(tiles);
+
+    animation = animation_from_rexfiles(filenames, TEST_FRAMES);
+    bool files_ok = animation != NULL && animation->frame_count == TEST_FRAMES;
+    if (animation) {
+        player = animation_player_create(animation);
+        animation_player_seek(player, TEST_FRAMES - 1);
+        files_ok = files_ok && player_matches(player, views);
+        animation_player_destroy(player);
+        animation_destroy(animation);
+    }
+    printf("Built from a file sequence: %s\n", files_ok ? "ok" : "WRONG");
+
+    for (uint32_t f = 0; f < TEST_FRAMES; f++) {
+        remove(names[f]);
+        console_view_destroy(views[f]);
+    }
+
+    return (playback_ok && seek_ok && files_ok) ? 0 : 1;
+}
+
+#endif
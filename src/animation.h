@@ -0,0 +1,102 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "console.h"
+
+
+/*
+ * Animations - sprite sequences stored as a base frame plus sparse per-frame deltas.
+ *
+ * Consecutive frames of a sprite animation usually differ in a handful of cells, so
+ * rather than a full view per frame an animation keeps frame 0 and, for each frame, the
+ * cells that change on the way to the next one (the last frame's deltas lead back to
+ * frame 0, so playback loops). An animation is an immutable asset that can be shared;
+ * each entity playing it owns an animation_player_t, whose view holds the current frame.
+ * Advancing a player writes only the cells that change.
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    uint32_t cell_index;        // row-major index into the frame
+    console_cell_t cell;
+} animation_delta_t;
+
+typedef struct {
+    uint32_t first_delta;       // deltas turning this frame into the next one
+    uint32_t delta_count;
+} animation_frame_t;
+
+typedef struct {
+    /* All values measured in cells */
+    uint32_t width;
+    uint32_t height;
+    uint32_t frame_count;
+    console_cell_t *base_cells;     // frame 0
+    animation_frame_t *frames;
+    animation_delta_t *deltas;
+    uint32_t delta_count;
+    uint32_t delta_capacity;
+} animation_t;
+// Should only use the animation via functions, not direct property access
+
+typedef struct {
+    const animation_t *animation;
+    uint32_t frame;
+    console_view_t *view;           // the current frame, in cells the player owns (never a mapping);
+                                    // draw it with console_screen_put_view_at
+} animation_player_t;
+
+
+/** Public Interface **/
+
+/**
+ *  Build an animation from a sequence of equally sized views, one per frame.
+ *  The views are only read. Returns NULL if the sizes differ or count is 0.
+ */
+animation_t * animation_from_views(console_view_t **views, uint32_t count);
+
+/**
+ *  Build an animation from a REXPaint file with one frame per layer, layer 0 first.
+ *  Each frame looks as it would if its layer were the only one in the file.
+ */
+animation_t * animation_from_rexfile(const char *filename);
+
+/**
+ *  Build an animation from a sequence of REXPaint files, one frame per file.
+ *  Only two decoded frames are held in memory at a time while building.
+ */
+animation_t * animation_from_rexfiles(const char **filenames, uint32_t count);
+
+void animation_destroy(animation_t *animation);
+
+/**
+ *  Bytes used by the animation's cells and deltas, for comparison with full views.
+ */
+size_t animation_memory_size(const animation_t *animation);
+
+/**
+ *  Create a player showing frame 0. The animation must outlive the player.
+ */
+animation_player_t * animation_player_create(const animation_t *animation);
+
+void animation_player_destroy(animation_player_t *player);
+
+/**
+ *  Move to the next frame, wrapping to frame 0 after the last. Returns the number of
+ *  cells that changed.
+ */
+uint32_t animation_player_advance(animation_player_t *player);
+
+/**
+ *  Jump to the given frame (modulo the frame count), replaying deltas from the current
+ *  frame, or from frame 0 when that is shorter.
+ */
+void animation_player_seek(animation_player_t *player, uint32_t frame);
+
+
+#endif
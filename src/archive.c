@@ -0,0 +1,206 @@
+
+
+#include "archive.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+#define ARCHIVE_BYTE_ORDER  0x01020304
+
+
+// Internal Functions --
+
+static int archive_compare_name(const archive_t *archive, const archive_entry_t *entry, const char *name, size_t name_length);
+
+
+// External Interface --
+
+archive_t * archive_open(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(archive_header_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Validate the header and index once, so lookups can trust them. Offsets and sizes are
+    // untrusted, so ranges are checked without adding them (a sum could wrap)
+    const archive_header_t *header = mapping;
+    uint64_t index_end = sizeof(archive_header_t) + (uint64_t)header->entry_count * sizeof(archive_entry_t);
+    bool valid = memcmp(header->magic, ARCHIVE_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == ARCHIVE_VERSION &&
+                 header->byte_order == ARCHIVE_BYTE_ORDER &&
+                 index_end <= size &&
+                 header->names_offset >= index_end &&
+                 header->names_offset <= size &&
+                 header->names_size <= size - header->names_offset;
+
+    const archive_entry_t *entries = (const archive_entry_t *)((const uint8_t *)mapping + sizeof(archive_header_t));
+    for (uint32_t i = 0; valid && i < header->entry_count; i++) {
+        const archive_entry_t *entry = &entries[i];
+        valid = ((uint64_t)entry->name_offset + entry->name_length <= header->names_size) &&
+                entry->data_offset <= size &&
+                entry->size <= size - entry->data_offset;
+    }
+
+    if (!valid) {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    archive_t *archive = calloc(1, sizeof(archive_t));
+    archive->data = mapping;
+    archive->size = size;
+    archive->header = header;
+    archive->entries = entries;
+    archive->names = (const char *)mapping + header->names_offset;
+
+    return archive;
+}
+
+void archive_close(archive_t *archive) {
+    munmap((void *)archive->data, archive->size);
+    free(archive);
+}
+
+const archive_entry_t * archive_find(const archive_t *archive, const char *name) {
+    size_t name_length = strlen(name);
+    uint32_t low = 0;
+    uint32_t high = archive->header->entry_count;
+    while (low < high) {
+        uint32_t mid = low + ((high - low) / 2);
+        int cmp = archive_compare_name(archive, &archive->entries[mid], name, name_length);
+        if (cmp == 0) {
+            return &archive->entries[mid];
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
+
+const void * archive_entry_data(const archive_t *archive, const archive_entry_t *entry) {
+    return archive->data + entry->data_offset;
+}
+
+uint32_t archive_entry_count(const archive_t *archive) {
+    return archive->header->entry_count;
+}
+
+const archive_entry_t * archive_entry_at(const archive_t *archive, uint32_t idx) {
+    if (idx >= archive->header->entry_count) {
+        return NULL;
+    }
+    return &archive->entries[idx];
+}
+
+
+// Internal Functions --
+
+/*
+ * Order an entry's name against the given name: bytewise, with a shorter prefix sorting first.
+ * This must match the order tools/pack sorts the index in.
+ */
+static
+int archive_compare_name(const archive_t *archive, const archive_entry_t *entry, const char *name, size_t name_length) {
+    size_t common = (entry->name_length < name_length) ? entry->name_length : name_length;
+    int cmp = memcmp(archive->names + entry->name_offset, name, common);
+    if (cmp != 0) {
+        return cmp;
+    }
+    if (entry->name_length == name_length) {
+        return 0;
+    }
+    return (entry->name_length < name_length) ? -1 : 1;
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <stdio.h>
+
+#define TEST_ARCHIVE    "/tmp/archive_test.pak"
+
+typedef struct {
+    archive_header_t header;
+    archive_entry_t entry;
+    char name[16];
+    uint8_t data[16];
+} test_archive_t;
+
+static bool write_and_open(const test_archive_t *contents) {
+    FILE *f = fopen(TEST_ARCHIVE, "wb");
+    fwrite(contents, sizeof(*contents), 1, f);
+    fclose(f);
+
+    archive_t *archive = archive_open(TEST_ARCHIVE);
+    if (archive == NULL) {
+        return false;
+    }
+    archive_close(archive);
+    return true;
+}
+
+int main() {
+    // One file, "cat.xp", laid out as tools/pack would
+    test_archive_t contents;
+    memset(&contents, 0, sizeof(contents));
+    memcpy(contents.header.magic, ARCHIVE_MAGIC, sizeof(contents.header.magic));
+    contents.header.version = ARCHIVE_VERSION;
+    contents.header.byte_order = ARCHIVE_BYTE_ORDER;
+    contents.header.entry_count = 1;
+    contents.header.names_offset = offsetof(test_archive_t, name);
+    contents.header.names_size = sizeof(contents.name);
+    contents.entry.data_offset = offsetof(test_archive_t, data);
+    contents.entry.size = sizeof(contents.data);
+    contents.entry.name_length = 6;
+    memcpy(contents.name, "cat.xp", 6);
+
+    bool valid_ok = write_and_open(&contents);
+
+    // Sizes that wrap offset + size past 2^64 back inside the file must be rejected
+    test_archive_t bad = contents;
+    bad.entry.size = UINT64_MAX - bad.entry.data_offset + 2;
+    bool data_wrap_rejected = !write_and_open(&bad);
+
+    bad = contents;
+    bad.header.names_size = UINT64_MAX - bad.header.names_offset + 2;
+    bool names_wrap_rejected = !write_and_open(&bad);
+
+    bad = contents;
+    bad.entry.data_offset = UINT64_MAX;
+    bad.entry.size = 1;
+    bool offset_rejected = !write_and_open(&bad);
+
+    printf("Valid archive opens: %s\n", valid_ok ? "yes" : "NO");
+    printf("Wrapping entry size rejected: %s, wrapping names size rejected: %s, huge offset rejected: %s\n",
+            data_wrap_rejected ? "yes" : "NO", names_wrap_rejected ? "yes" : "NO", offset_rejected ? "yes" : "NO");
+    remove(TEST_ARCHIVE);
+
+    return (valid_ok && data_wrap_rejected && names_wrap_rejected && offset_rejected) ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * Asset archive - many asset files packed into one, read through a single mmap.
+ *
+ * Layout (native byte order):
+ *   archive_header_t
+ *   archive_entry_t[entry_count]   sorted by name, so lookups are a binary search
+ *   name strings                   not NUL-terminated; entries hold offset + length
+ *   file data                      each file aligned to ARCHIVE_DATA_ALIGNMENT
+ *
+ * Entries are stored as-is; compression records whether the stored bytes are
+ * compressed (REXPaint files already are), so loaders know how to read them.
+ * Build archives with tools/pack.
+ */
+
+
+#define ARCHIVE_MAGIC           "APAK"
+#define ARCHIVE_VERSION         1
+#define ARCHIVE_DATA_ALIGNMENT  16
+
+typedef enum {
+    ARCHIVE_COMPRESSION_NONE = 0,
+    ARCHIVE_COMPRESSION_GZIP = 1,
+} archive_compression_t;
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;    // 0x01020304 as written by the host that created the archive
+    uint32_t entry_count;
+    uint64_t names_offset;
+    uint64_t names_size;
+} archive_header_t;
+
+typedef struct {
+    uint64_t data_offset;
+    uint64_t size;          // stored size in bytes
+    uint32_t name_offset;   // relative to header.names_offset
+    uint32_t name_length;
+    uint32_t compression;   // archive_compression_t
+    uint32_t reserved;
+} archive_entry_t;
+
+typedef struct {
+    const uint8_t *data;    // the whole mapped archive
+    size_t size;
+    const archive_header_t *header;
+    const archive_entry_t *entries;
+    const char *names;
+} archive_t;
+
+
+/**
+ *  Map the archive at the given path and validate its index.
+ *  Returns NULL if it can't be opened or isn't a valid archive.
+ */
+archive_t * archive_open(const char *filename);
+
+void archive_close(archive_t *archive);
+
+/**
+ *  Find the entry with the given name (the path it was packed under, e.g. "assets/cat.xp").
+ *  Returns NULL if there is no such entry.
+ */
+const archive_entry_t * archive_find(const archive_t *archive, const char *name);
+
+/**
+ *  The entry's stored bytes, in place in the mapping. Valid until the archive is closed.
+ */
+const void * archive_entry_data(const archive_t *archive, const archive_entry_t *entry);
+
+uint32_t archive_entry_count(const archive_t *archive);
+
+const archive_entry_t * archive_entry_at(const archive_t *archive, uint32_t idx);
+
+
+#endif
+
@@ -0,0 +1,331 @@
+
+
+#include "asset_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+#include "view_file.h"
+
+
+#define ASSET_WATCH_INTERVAL_MS     250
+
+
+// Internal Functions --
+
+static asset_entry_t * asset_cache_find(asset_cache_t *cache, const char *path);
+static void asset_entry_destroy(asset_entry_t *entry);
+static void asset_cache_watch_entry(asset_cache_t *cache, asset_entry_t *entry);
+static void asset_cache_unwatch_entry(asset_cache_t *cache, asset_entry_t *entry);
+static list_t * asset_cache_wait_for_changes(asset_cache_t *cache);
+static int asset_cache_watcher(void *data);
+
+
+// External Interface --
+
+asset_cache_t * asset_cache_create(bool watch_files) {
+    asset_cache_t *cache = calloc(1, sizeof(asset_cache_t));
+    cache->entries = list_create((void (*)(void *))asset_entry_destroy);
+    cache->lock = SDL_CreateMutex();
+    cache->watch_fd = -1;
+
+    if (watch_files) {
+#ifdef __linux__
+        cache->watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+        SDL_AtomicSet(&cache->running, 1);
+        cache->watcher = SDL_CreateThread(asset_cache_watcher, "asset_cache_watcher", cache);
+    }
+
+    return cache;
+}
+
+void asset_cache_destroy(asset_cache_t *cache) {
+    if (cache->watcher != NULL) {
+        SDL_AtomicSet(&cache->running, 0);
+        SDL_WaitThread(cache->watcher, NULL);
+    }
+    if (cache->watch_fd >= 0) {
+        close(cache->watch_fd);
+    }
+
+    list_destroy(cache->entries);
+    SDL_DestroyMutex(cache->lock);
+    free(cache);
+}
+
+asset_entry_t * asset_cache_acquire(asset_cache_t *cache, const char *path) {
+    SDL_LockMutex(cache->lock);
+    asset_entry_t *entry = asset_cache_find(cache, path);
+    if (entry != NULL) {
+        entry->ref_count += 1;
+    }
+    SDL_UnlockMutex(cache->lock);
+    if (entry != NULL) {
+        return entry;
+    }
+
+    // First request for this path: decode it outside the lock so the watcher isn't held up
+    console_view_t *view = asset_load_view(path);
+    if (view == NULL) {
+        return NULL;
+    }
+
+    entry = calloc(1, sizeof(asset_entry_t));
+    entry->path = strdup(path);
+    entry->ref_count = 1;
+    entry->view = view;
+    entry->watch_descriptor = -1;
+    const char *slash = strrchr(entry->path, '/');
+    entry->file_name = (slash != NULL) ? slash + 1 : entry->path;
+
+    struct stat st;
+    if (stat(path, &st) == 0) {
+        entry->modified_time = st.st_mtime;
+    }
+
+    SDL_LockMutex(cache->lock);
+    asset_cache_watch_entry(cache, entry);
+    list_append(cache->entries, entry);
+    SDL_UnlockMutex(cache->lock);
+
+    return entry;
+}
+
+void asset_cache_release(asset_cache_t *cache, asset_entry_t *entry) {
+    SDL_LockMutex(cache->lock);
+    entry->ref_count -= 1;
+    if (entry->ref_count == 0) {
+        list_remove_data(cache->entries, entry);
+        asset_cache_unwatch_entry(cache, entry);
+        asset_entry_destroy(entry);
+    }
+    SDL_UnlockMutex(cache->lock);
+}
+
+uint32_t asset_cache_update(asset_cache_t *cache) {
+    uint32_t swapped = 0;
+
+    // Only the game thread changes the entry list, so it can be walked without the lock
+    list_iterator_t *iter = list_iterator(cache->entries);
+    while (list_iterator_next(iter)) {
+        asset_entry_t *entry = list_iterator_data(iter);
+        console_view_t *pending = SDL_AtomicSetPtr((void **)&entry->pending, NULL);
+        if (pending != NULL) {
+            console_view_t *old = SDL_AtomicSetPtr((void **)&entry->view, pending);
+            console_view_destroy(old);
+            swapped += 1;
+        }
+    }
+    list_iterator_destroy(iter);
+
+    return swapped;
+}
+
+console_view_t * asset_entry_view(asset_entry_t *entry) {
+    return SDL_AtomicGetPtr((void **)&entry->view);
+}
+
+console_view_t * asset_load_view(const char *path) {
+    const char *ext = strrchr(path, '.');
+    if (ext != NULL && strcmp(ext, ".view") == 0) {
+        return view_file_load(path);
+    }
+    return console_view_from_rexfile(path);
+}
+
+
+// Internal Functions --
+
+/*
+ * Find the entry for the given path. Caller must hold the cache lock.
+ */
+static
+asset_entry_t * asset_cache_find(asset_cache_t *cache, const char *path) {
+    asset_entry_t *found = NULL;
+    list_iterator_t *iter = list_iterator(cache->entries);
+    while (list_iterator_next(iter)) {
+        asset_entry_t *entry = list_iterator_data(iter);
+        if (strcmp(entry->path, path) == 0) {
+            found = entry;
+            break;
+        }
+    }
+    list_iterator_destroy(iter);
+
+    return found;
+}
+
+static
+void asset_entry_destroy(asset_entry_t *entry) {
+    console_view_destroy(entry->view);
+    if (entry->pending != NULL) {
+        console_view_destroy(entry->pending);
+    }
+    free(entry->path);
+    free(entry);
+}
+
+/*
+ * Start watching the directory containing the entry's file. Watching the directory rather
+ * than the file itself catches editors that save by writing a new file and renaming it over
+ * the old one. Caller must hold the cache lock.
+ */
+static
+void asset_cache_watch_entry(asset_cache_t *cache, asset_entry_t *entry) {
+#ifdef __linux__
+    if (cache->watch_fd < 0) { return; }
+
+    size_t dir_len = (size_t)(entry->file_name - entry->path);
+    char *dir = (dir_len > 0) ? strndup(entry->path, dir_len) : strdup(".");
+    // inotify hands back the existing descriptor when the directory is already watched
+    entry->watch_descriptor = inotify_add_watch(cache->watch_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+    free(dir);
+#else
+    (void)cache;
+    (void)entry;
+#endif
+}
+
+/*
+ * Stop watching the entry's directory if no other entry lives there. Caller must hold the cache lock.
+ */
+static
+void asset_cache_unwatch_entry(asset_cache_t *cache, asset_entry_t *entry) {
+#ifdef __linux__
+    if (cache->watch_fd < 0 || entry->watch_descriptor < 0) { return; }
+
+    bool shared = false;
+    list_iterator_t *iter = list_iterator(cache->entries);
+    while (list_iterator_next(iter)) {
+        asset_entry_t *other = list_iterator_data(iter);
+        if (other != entry && other->watch_descriptor == entry->watch_descriptor) {
+            shared = true;
+            break;
+        }
+    }
+    list_iterator_destroy(iter);
+
+    if (!shared) {
+        inotify_rm_watch(cache->watch_fd, entry->watch_descriptor);
+    }
+#else
+    (void)cache;
+    (void)entry;
+#endif
+}
+
+static
+void append_unique_path(list_t *paths, const char *path) {
+    list_iterator_t *iter = list_iterator(paths);
+    while (list_iterator_next(iter)) {
+        if (strcmp(list_iterator_data(iter), path) == 0) {
+            list_iterator_destroy(iter);
+            return;
+        }
+    }
+    list_iterator_destroy(iter);
+    list_append(paths, strdup(path));
+}
+
+/*
+ * Wait up to ASSET_WATCH_INTERVAL_MS for cached files to change, and return a list of the
+ * paths that did (possibly empty). The caller owns the list and its strings.
+ */
+static
+list_t * asset_cache_wait_for_changes(asset_cache_t *cache) {
+    list_t *changed = list_create(free);
+
+#ifdef __linux__
+    if (cache->watch_fd >= 0) {
+        struct pollfd pfd = { cache->watch_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, ASSET_WATCH_INTERVAL_MS) <= 0) {
+            return changed;
+        }
+
+        char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        ssize_t len;
+        while ((len = read(cache->watch_fd, buffer, sizeof(buffer))) > 0) {
+            SDL_LockMutex(cache->lock);
+            for (char *ptr = buffer; ptr < buffer + len; ) {
+                struct inotify_event *event = (struct inotify_event *)ptr;
+                if (event->len > 0) {
+                    list_iterator_t *iter = list_iterator(cache->entries);
+                    while (list_iterator_next(iter)) {
+                        asset_entry_t *entry = list_iterator_data(iter);
+                        if (entry->watch_descriptor == event->wd && strcmp(entry->file_name, event->name) == 0) {
+                            append_unique_path(changed, entry->path);
+                        }
+                    }
+                    list_iterator_destroy(iter);
+                }
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+            SDL_UnlockMutex(cache->lock);
+        }
+        return changed;
+    }
+#endif
+
+    // No change notifications available: poll modification times instead
+    SDL_Delay(ASSET_WATCH_INTERVAL_MS);
+    SDL_LockMutex(cache->lock);
+    list_iterator_t *iter = list_iterator(cache->entries);
+    while (list_iterator_next(iter)) {
+        asset_entry_t *entry = list_iterator_data(iter);
+        struct stat st;
+        if (stat(entry->path, &st) == 0 && st.st_mtime != entry->modified_time) {
+            entry->modified_time = st.st_mtime;
+            append_unique_path(changed, entry->path);
+        }
+    }
+    list_iterator_destroy(iter);
+    SDL_UnlockMutex(cache->lock);
+
+    return changed;
+}
+
+/*
+ * Background thread: decode changed files and hand the new views to their entries.
+ */
+static
+int asset_cache_watcher(void *data) {
+    asset_cache_t *cache = data;
+
+    while (SDL_AtomicGet(&cache->running)) {
+        list_t *changed = asset_cache_wait_for_changes(cache);
+
+        list_iterator_t *iter = list_iterator(changed);
+        while (list_iterator_next(iter)) {
+            const char *path = list_iterator_data(iter);
+
+            // A file caught mid-write won't decode; the write finishing will trigger another attempt
+            console_view_t *view = asset_load_view(path);
+            if (view == NULL) { continue; }
+
+            SDL_LockMutex(cache->lock);
+            asset_entry_t *entry = asset_cache_find(cache, path);
+            if (entry != NULL) {
+                view = SDL_AtomicSetPtr((void **)&entry->pending, view);
+            }
+            SDL_UnlockMutex(cache->lock);
+
+            // Either the entry was released meanwhile, or this replaces a reload nobody swapped in yet
+            if (view != NULL) {
+                console_view_destroy(view);
+            }
+        }
+        list_iterator_destroy(iter);
+        list_destroy(changed);
+    }
+
+    return 0;
+}
+
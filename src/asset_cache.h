@@ -0,0 +1,96 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <SDL2/SDL.h>
+
+#include "console.h"
+#include "list.h"
+
+
+/*
+ * Asset cache - shared, reference-counted console views keyed by file path.
+ *
+ * Acquiring a path that is already loaded returns the same entry, so a sprite used
+ * by many entities is decoded once. A background thread watches the cached files
+ * (inotify on Linux, modification times elsewhere) and decodes changed ones; the new
+ * view is swapped into the entry on the next asset_cache_update(), so everything
+ * holding the entry picks it up without restarting.
+ *
+ * Cached views are shared and must be treated as immutable. Fetch the view from the
+ * entry with asset_entry_view() each frame rather than keeping the pointer: a reload
+ * destroys the previous view during asset_cache_update().
+ *
+ * acquire, release and update must be called from the game thread.
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    char *path;
+    uint32_t ref_count;
+    console_view_t *view;       // current view; swapped atomically on reload
+    console_view_t *pending;    // freshly reloaded view waiting for asset_cache_update()
+    int watch_descriptor;       // inotify watch on the containing directory
+    const char *file_name;      // points into path, past the last '/'
+    time_t modified_time;
+} asset_entry_t;
+
+typedef struct {
+    list_t *entries;
+    SDL_mutex *lock;
+    SDL_Thread *watcher;
+    SDL_atomic_t running;
+    int watch_fd;
+} asset_cache_t;
+// Should only use the cache via functions, not direct property access
+
+
+/** Public Interface **/
+
+/**
+ *  Create a cache. If watch_files is true a background thread reloads cached
+ *  views whenever their files change on disk.
+ */
+asset_cache_t * asset_cache_create(bool watch_files);
+
+/**
+ *  Destroy the cache and every view in it. All entries should have been released.
+ */
+void asset_cache_destroy(asset_cache_t *cache);
+
+/**
+ *  Return the entry for the given path, loading it if this is the first request.
+ *  Each successful acquire must be balanced by asset_cache_release.
+ *  Returns NULL if the asset can't be loaded.
+ */
+asset_entry_t * asset_cache_acquire(asset_cache_t *cache, const char *path);
+
+/**
+ *  Drop a reference to the given entry. The view is destroyed with the last reference.
+ */
+void asset_cache_release(asset_cache_t *cache, asset_entry_t *entry);
+
+/**
+ *  Swap in any views reloaded by the watcher thread and destroy the ones they replace.
+ *  Call once per frame, before drawing. Returns the number of views swapped.
+ */
+uint32_t asset_cache_update(asset_cache_t *cache);
+
+/**
+ *  The entry's current view.
+ */
+console_view_t * asset_entry_view(asset_entry_t *entry);
+
+/**
+ *  Load a view from the given file: precompiled view files (".view") are mapped,
+ *  anything else is decoded as a REXPaint file.
+ */
+console_view_t * asset_load_view(const char *path);
+
+
+#endif
+
@@ -0,0 +1,175 @@
+
+
+#include "asset_loader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asset_cache.h"
+#include "rex_loader.h"
+
+
+// Internal Functions --
+
+static int asset_loader_worker(void *data);
+static void asset_loader_push_completed(asset_loader_t *loader, asset_load_result_t *result);
+
+
+// External Interface --
+
+asset_loader_t * asset_loader_create(uint32_t worker_count) {
+    if (worker_count == 0) {
+        int cpu_count = SDL_GetCPUCount();
+        worker_count = (cpu_count > 0) ? (uint32_t)cpu_count : 1;
+    }
+
+    asset_loader_t *loader = calloc(1, sizeof(asset_loader_t));
+    loader->worker_count = worker_count;
+    loader->jobs = list_create(free);
+    loader->job_lock = SDL_CreateMutex();
+    loader->job_signal = SDL_CreateSemaphore(0);
+    SDL_AtomicSet(&loader->running, 1);
+
+    loader->workers = calloc(worker_count, sizeof(SDL_Thread *));
+    for (uint32_t i = 0; i < worker_count; i++) {
+        loader->workers[i] = SDL_CreateThread(asset_loader_worker, "asset_loader", loader);
+    }
+
+    return loader;
+}
+
+void asset_loader_destroy(asset_loader_t *loader) {
+    SDL_AtomicSet(&loader->running, 0);
+    for (uint32_t i = 0; i < loader->worker_count; i++) {
+        SDL_SemPost(loader->job_signal);
+    }
+    for (uint32_t i = 0; i < loader->worker_count; i++) {
+        SDL_WaitThread(loader->workers[i], NULL);
+    }
+
+    asset_load_result_t result;
+    while (asset_loader_poll(loader, &result)) {
+        if (result.view != NULL) {
+            console_view_destroy(result.view);
+        }
+    }
+
+    list_destroy(loader->jobs);
+    SDL_DestroySemaphore(loader->job_signal);
+    SDL_DestroyMutex(loader->job_lock);
+    free(loader->workers);
+    free(loader);
+}
+
+asset_batch_t * asset_loader_load(asset_loader_t *loader, const char **paths, uint32_t count) {
+    asset_batch_t *batch = calloc(1, sizeof(asset_batch_t));
+    batch->total = count;
+
+    SDL_LockMutex(loader->job_lock);
+    for (uint32_t i = 0; i < count; i++) {
+        asset_load_result_t *job = calloc(1, sizeof(asset_load_result_t));
+        job->batch = batch;
+        job->index = i;
+        job->path = paths[i];
+        list_append(loader->jobs, job);
+    }
+    SDL_UnlockMutex(loader->job_lock);
+
+    for (uint32_t i = 0; i < count; i++) {
+        SDL_SemPost(loader->job_signal);
+    }
+
+    return batch;
+}
+
+bool asset_loader_poll(asset_loader_t *loader, asset_load_result_t *result) {
+    if (loader->ready == NULL) {
+        // Take everything the workers have pushed in one exchange. The stack comes back
+        // newest-first, so reverse it to hand results out in completion order.
+        asset_load_result_t *stack = SDL_AtomicSetPtr(&loader->completed, NULL);
+        while (stack != NULL) {
+            asset_load_result_t *next = stack->next;
+            stack->next = loader->ready;
+            loader->ready = stack;
+            stack = next;
+        }
+    }
+
+    asset_load_result_t *finished = loader->ready;
+    if (finished == NULL) {
+        return false;
+    }
+    loader->ready = finished->next;
+
+    *result = *finished;
+    result->next = NULL;
+    free(finished);
+
+    return true;
+}
+
+uint32_t asset_batch_progress(asset_batch_t *batch) {
+    return (uint32_t)SDL_AtomicGet(&batch->completed);
+}
+
+bool asset_batch_done(asset_batch_t *batch) {
+    return asset_batch_progress(batch) == batch->total;
+}
+
+void asset_batch_destroy(asset_batch_t *batch) {
+    free(batch);
+}
+
+
+// Internal Functions --
+
+static
+int asset_loader_worker(void *data) {
+    asset_loader_t *loader = data;
+
+    while (1) {
+        SDL_SemWait(loader->job_signal);
+        if (!SDL_AtomicGet(&loader->running)) {
+            break;
+        }
+
+        SDL_LockMutex(loader->job_lock);
+        asset_load_result_t *job = list_remove_first(loader->jobs);
+        SDL_UnlockMutex(loader->job_lock);
+        if (job == NULL) { continue; }
+
+        job->view = asset_load_view(job->path);
+        asset_batch_t *batch = job->batch;
+        if (job->view == NULL) {
+            // The REX error is per thread, so it has to be taken here; view files don't set it
+            const char *ext = strrchr(job->path, '.');
+            if (ext != NULL && strcmp(ext, ".view") == 0) {
+                snprintf(job->error, sizeof(job->error), "%s: unable to map view file", job->path);
+            } else {
+                snprintf(job->error, sizeof(job->error), "%s", rex_get_error());
+            }
+            SDL_AtomicAdd(&batch->failed, 1);
+        }
+
+        // Publish the result before counting it, so a done batch has all its results pollable
+        asset_loader_push_completed(loader, job);
+        SDL_AtomicAdd(&batch->completed, 1);
+    }
+
+    return 0;
+}
+
+/*
+ * Push a finished result onto the completion stack. Any number of workers may push at once;
+ * the game thread only ever takes the whole stack, so there is no ABA problem.
+ */
+static
+void asset_loader_push_completed(asset_loader_t *loader, asset_load_result_t *result) {
+    void *head;
+    do {
+        head = SDL_AtomicGetPtr(&loader->completed);
+        result->next = head;
+    } while (!SDL_AtomicCASPtr(&loader->completed, head, result));
+}
+
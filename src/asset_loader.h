@@ -0,0 +1,90 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+#include "console.h"
+#include "list.h"
+
+
+/*
+ * Asset loader - decode batches of views on a pool of worker threads.
+ *
+ * A batch of paths is queued with asset_loader_load and decoded in parallel. Each
+ * finished view is pushed onto a lock-free completion queue, which the game loop
+ * drains with asset_loader_poll while it keeps animating a loading screen. Workers
+ * never block on the game thread and the game thread never blocks on a worker.
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    uint32_t total;
+    SDL_atomic_t completed;
+    SDL_atomic_t failed;
+} asset_batch_t;
+
+typedef struct asset_load_result_s {
+    asset_batch_t *batch;
+    uint32_t index;             // position of the path in the batch
+    const char *path;           // the caller's string, as passed to asset_loader_load
+    console_view_t *view;       // NULL if the asset couldn't be loaded
+    char error[256];            // why it couldn't, empty on success
+    struct asset_load_result_s *next;
+} asset_load_result_t;
+
+typedef struct {
+    uint32_t worker_count;
+    SDL_Thread **workers;
+    SDL_atomic_t running;
+    list_t *jobs;               // asset_load_result_t waiting for a worker
+    SDL_mutex *job_lock;
+    SDL_sem *job_signal;
+    void *completed;            // lock-free stack of finished results, pushed by workers
+    asset_load_result_t *ready; // finished results in completion order, owned by the game thread
+} asset_loader_t;
+// Should only use the loader via functions, not direct property access
+
+
+/** Public Interface **/
+
+/**
+ *  Create a loader with the given number of worker threads (0 for one per CPU core).
+ */
+asset_loader_t * asset_loader_create(uint32_t worker_count);
+
+/**
+ *  Stop the workers and destroy the loader. Queued loads are abandoned, and views
+ *  that finished but were never polled are destroyed.
+ */
+void asset_loader_destroy(asset_loader_t *loader);
+
+/**
+ *  Queue the given paths for loading (see asset_load_view for supported formats).
+ *  The path strings must stay valid until their results have been polled.
+ *  Destroy the returned batch with asset_batch_destroy once it is done.
+ */
+asset_batch_t * asset_loader_load(asset_loader_t *loader, const char **paths, uint32_t count);
+
+/**
+ *  Take the next finished load, if any. Ownership of result->view passes to the caller;
+ *  when it is NULL, result->error says why (rex_get_error can't, as the load ran on a
+ *  worker thread). Never blocks. Returns false when nothing has finished since the last poll.
+ */
+bool asset_loader_poll(asset_loader_t *loader, asset_load_result_t *result);
+
+/**
+ *  Loads finished so far (successful or not), out of batch->total.
+ */
+uint32_t asset_batch_progress(asset_batch_t *batch);
+
+bool asset_batch_done(asset_batch_t *batch);
+
+void asset_batch_destroy(asset_batch_t *batch);
+
+
+#endif
+
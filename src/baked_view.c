@@ -0,0 +1,190 @@
+
+
+#include "baked_view.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Internal Functions --
+
+static bool baked_view_draw_texture(console_baked_view_t *baked);
+static void baked_view_draw_pixels(console_baked_view_t *baked);
+
+
+// External Interface --
+
+console_baked_view_t * console_bake_view(console_t *console, const console_view_t *view) {
+    uint32_t width = view->width * console->cell_width;
+    uint32_t height = view->height * console->cell_height;
+    SDL_Texture *texture = SDL_CreateTexture(console->renderer, SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_TARGET, (int)width, (int)height);
+    if (texture == NULL) {
+        return NULL;
+    }
+
+    console_baked_view_t *baked = calloc(1, sizeof(console_baked_view_t));
+    baked->view = view;
+    baked->width = width;
+    baked->height = height;
+    baked->console = console;
+    baked->texture = texture;
+
+    if (!baked_view_draw_texture(baked)) {
+        console_baked_view_destroy(baked);
+        return NULL;
+    }
+    return baked;
+}
+
+console_baked_view_t * console_bake_view_pixels(const console_view_t *view, const embedded_font_t *font) {
+    if (font == NULL) {
+        font = &console_embedded_font;
+    }
+
+    uint32_t width = view->width * font->glyph_width;
+    uint32_t height = view->height * font->glyph_height;
+    uint32_t *pixels = malloc((size_t)width * height * sizeof(uint32_t));
+    if (pixels == NULL) {
+        return NULL;
+    }
+
+    console_baked_view_t *baked = calloc(1, sizeof(console_baked_view_t));
+    baked->view = view;
+    baked->width = width;
+    baked->height = height;
+    baked->font = font;
+    baked->pixels = pixels;
+
+    baked_view_draw_pixels(baked);
+    return baked;
+}
+
+void console_baked_view_destroy(console_baked_view_t *baked) {
+    if (baked->texture != NULL) {
+        SDL_DestroyTexture(baked->texture);
+    }
+    free(baked->pixels);
+    free(baked);
+}
+
+bool console_baked_view_update(console_baked_view_t *baked) {
+    if (baked->version == baked->view->version) {
+        return false;
+    }
+
+    if (baked->texture != NULL) {
+        return baked_view_draw_texture(baked);
+    }
+    baked_view_draw_pixels(baked);
+    return true;
+}
+
+void console_draw_baked_view(console_t *console, console_baked_view_t *baked, uint32_t x, uint32_t y) {
+    if (baked->texture == NULL) {
+        return;
+    }
+
+    console_baked_view_update(baked);
+    SDL_Rect dst_rect = {x * console->cell_width, y * console->cell_height, baked->width, baked->height};
+    SDL_RenderCopy(console->renderer, baked->texture, NULL, &dst_rect);
+}
+
+
+// Internal Functions --
+
+/*
+ * Draw the view into the bake's texture with the console's usual cell drawing.
+ */
+static
+bool baked_view_draw_texture(console_baked_view_t *baked) {
+    console_t *console = baked->console;
+    SDL_Texture *previous_target = SDL_GetRenderTarget(console->renderer);
+    if (SDL_SetRenderTarget(console->renderer, baked->texture) != 0) {
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(console->renderer, 0, 0, 0, 255);
+    SDL_RenderClear(console->renderer);
+
+    // Borrow the view's cells as a screen; drawing only reads them
+    console_screen_t screen = { .width = baked->view->width, .height = baked->view->height, .cells = baked->view->cells };
+    console_draw_screen(console, &screen);
+
+    SDL_SetRenderTarget(console->renderer, previous_target);
+    baked->version = baked->view->version;
+    return true;
+}
+
+static
+void baked_view_draw_pixels(console_baked_view_t *baked) {
+    const console_view_t *view = baked->view;
+    const embedded_font_t *font = baked->font;
+    static const uint32_t black = COLOR_FROM_RGBA(0, 0, 0, 255);
+
+    for (uint32_t cell_y = 0; cell_y < view->height; cell_y++) {
+        for (uint32_t cell_x = 0; cell_x < view->width; cell_x++) {
+            const console_cell_t *cell = &view->cells[(cell_y * view->width) + cell_x];
+            uint32_t fg_color = cell->fg_color | 0xff;
+            bool has_glyph = cell->glyph < font->glyph_count;
+
+            uint32_t *row = &baked->pixels[((size_t)cell_y * font->glyph_height * baked->width) + (cell_x * font->glyph_width)];
+            for (uint32_t y = 0; y < font->glyph_height; y++, row += baked->width) {
+                for (uint32_t x = 0; x < font->glyph_width; x++) {
+                    row[x] = (has_glyph && embedded_font_pixel(font, cell->glyph, x, y)) ? fg_color : black;
+                }
+            }
+        }
+    }
+    baked->version = view->version;
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <time.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+int main() {
+    console_view_t *view = console_view_from_rexfile("assets/screen.xp");
+    if (view == NULL) {
+        printf("Unable to load assets/screen.xp: %s\n", rex_get_error());
+        return 1;
+    }
+
+    double start = now_seconds();
+    console_baked_view_t *baked = console_bake_view_pixels(view, NULL);
+    printf("Baked %ux%u cells to %ux%u pixels in %.2f ms\n", view->width, view->height,
+            baked->width, baked->height, (now_seconds() - start) * 1000.0);
+
+    // A cell showing a full block glyph comes out as a solid block of its foreground color
+    console_cell_t block = { 219, COLOR_FROM_RGBA(200, 100, 50, 255), COLOR_FROM_RGBA(0, 0, 0, 255) };
+    console_view_set_cell(view, 5, 3, block);
+    bool rebaked = console_baked_view_update(baked);
+    bool unchanged = !console_baked_view_update(baked);
+    uint32_t centre = baked->pixels[((3 * 16 + 8) * baked->width) + (5 * 10 + 5)];
+    printf("Changed view re-baked: %s, unchanged view skipped: %s, block pixel %08x\n",
+            rebaked ? "yes" : "NO", unchanged ? "yes" : "NO", centre);
+
+    // Blank glyph 0 is all background
+    console_view_set_cell(view, 0, 0, (console_cell_t){ 0, COLOR_FROM_RGBA(255, 255, 255, 255), 0 });
+    console_baked_view_update(baked);
+    bool blank = baked->pixels[0] == (uint32_t)COLOR_FROM_RGBA(0, 0, 0, 255);
+    printf("Glyph 0 is background only: %s\n", blank ? "yes" : "NO");
+
+    console_baked_view_destroy(baked);
+    console_view_destroy(view);
+
+    return (rebaked && unchanged && blank && centre == (uint32_t)COLOR_FROM_RGBA(200, 100, 50, 255)) ? 0 : 1;
+}
+
+#endif
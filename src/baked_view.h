@@ -0,0 +1,80 @@
+#ifndef BAKED_VIEW_H
+#define BAKED_VIEW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+#include "console.h"
+#include "embedded_font.h"
+
+
+/*
+ * Baked views - views rasterized once and then drawn as a single image.
+ *
+ * Drawing a view through a screen costs one glyph copy per cell every frame. For views
+ * that rarely change (panels, frames, large static sprites) that work can be done once:
+ * a baked view holds the view already drawn into a texture, and drawing it is a single
+ * copy. A view's version (see console_view_touch) is recorded when it is baked, and a
+ * stale bake is redrawn the next time it is drawn or updated.
+ *
+ * Views can also be baked to pixels in memory using an embedded font, with no renderer
+ * at all, for headless use such as thumbnails or tests. Pixels are RGBA in the same
+ * packing as console colors.
+ *
+ * Baked output matches console_draw_screen: glyph pixels in the cell's foreground color
+ * over the font's black. A baked view refers to its view, which must outlive it.
+ *
+ *  Example usage:
+ *      console_baked_view_t *panel = console_bake_view(console, panel_view);
+ *      ...
+ *      console_draw_screen(console, screen);
+ *      console_draw_baked_view(console, panel, 2, 2);
+ *      console_present(console);
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    const console_view_t *view;
+    uint32_t version;               // view version the bake reflects
+    uint32_t width;                 // pixels
+    uint32_t height;                // pixels
+    console_t *console;             // texture bakes: console the texture belongs to
+    SDL_Texture *texture;
+    const embedded_font_t *font;    // pixel bakes: font the pixels were drawn with
+    uint32_t *pixels;               // width * height, row-major
+} console_baked_view_t;
+// Should only use the baked view via functions, not direct property access
+
+
+/** Public Interface **/
+
+/**
+ *  Bake the view into a texture for the given console, in the console's cell size.
+ *  Returns NULL if the texture can't be created.
+ */
+console_baked_view_t * console_bake_view(console_t *console, const console_view_t *view);
+
+/**
+ *  Bake the view into pixels in memory using the given embedded font (NULL for the
+ *  default console font). Needs no renderer.
+ */
+console_baked_view_t * console_bake_view_pixels(const console_view_t *view, const embedded_font_t *font);
+
+void console_baked_view_destroy(console_baked_view_t *baked);
+
+/**
+ *  Re-bake if the view has changed since it was baked. Returns true if it was re-baked.
+ */
+bool console_baked_view_update(console_baked_view_t *baked);
+
+/**
+ *  Draw a texture bake with its top left corner at cell (x, y), updating it first if the
+ *  view has changed. Draw after console_draw_screen and before console_present.
+ */
+void console_draw_baked_view(console_t *console, console_baked_view_t *baked, uint32_t x, uint32_t y);
+
+
+#endif
@@ -1,85 +1,289 @@
 
 #include "console.h"
 
+#include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
 #include <SDL2/SDL.h>
+#ifndef CONSOLE_NO_SDL_IMAGE
 #include <SDL2/SDL_image.h>
+#endif
+#include "embedded_font.h"
 #include "rex_loader.h"
 
 
 // Internal Functions --
 
-static uint32_t view_cell_index_for_rex_index(const uint32_t rex_idx, const uint32_t width, const uint32_t height);
+// Side of the square blocks used when transposing column-major REX tiles into row-major cells
+#define VIEW_TRANSPOSE_BLOCK_SIZE   32
+// Approximate size of the tile window used when streaming a REX file (always at least one column)
+#define VIEW_STREAM_WINDOW_SIZE     (256 * 1024)
+
+static console_t * console_create_with_font_surface(SDL_Window *window, 
+        uint32_t width, uint32_t height, 
+        uint32_t row_count, uint32_t col_count,
+        uint32_t bg_color, SDL_Surface *image,
+        uint32_t glyph_width, uint32_t glyph_height);
+static bool console_create_native_target(console_t *console);
+static bool console_screen_row_stale(const console_screen_t *screen, uint32_t y);
+static void console_screen_refresh_row(console_screen_t *screen, uint32_t y);
+static console_view_t * console_view_from_rex_stream(rex_stream_t *stream);
+static bool view_cells_read_rex_layer(rex_stream_t *stream, console_cell_t *cells, rex_tile_t *window, uint32_t window_columns, bool first_layer);
+static void view_cells_fold_rex_columns(console_cell_t *cells, uint32_t width, uint32_t height, const rex_tile_t *tiles, uint32_t tile_stride, uint32_t first_column, uint32_t column_count, bool first_layer);
+static void view_cells_fill_blanks(console_cell_t *cells, size_t cell_count);
+static rex_tile_t * view_stream_window(rex_stream_t *stream, uint32_t *window_columns);
+static console_view_t * layered_view_find_composite(console_layered_view_t *layered, uint32_t layer_mask);
 
 
 // External Interface --
 
 /* Console Management */
 
+#ifndef CONSOLE_NO_SDL_IMAGE
+
 console_t * console_create(SDL_Window *window, 
         uint32_t width, uint32_t height, 
         uint32_t row_count, uint32_t col_count,
         uint32_t bg_color, const char *font_filename) {
 
-	SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (renderer == NULL) {
+    SDL_Surface *image = IMG_Load(font_filename);
+    return console_create_with_font_surface(window, width, height, row_count, col_count, bg_color, image,
+            CONSOLE_DEFAULT_GLYPH_WIDTH, CONSOLE_DEFAULT_GLYPH_HEIGHT);
+}
+
+console_t * console_create_from_font_data(SDL_Window *window, 
+        uint32_t width, uint32_t height, 
+        uint32_t row_count, uint32_t col_count,
+        uint32_t bg_color, const void *font_data, size_t font_size) {
+
+    SDL_RWops *rw = SDL_RWFromConstMem(font_data, (int)font_size);
+    if (rw == NULL) {
         return NULL;
     }
-	SDL_RenderSetLogicalSize(renderer, width, height);
+    SDL_Surface *image = IMG_Load_RW(rw, 1);
+    return console_create_with_font_surface(window, width, height, row_count, col_count, bg_color, image,
+            CONSOLE_DEFAULT_GLYPH_WIDTH, CONSOLE_DEFAULT_GLYPH_HEIGHT);
+}
 
-    SDL_Surface *image = IMG_Load(font_filename);
+#endif
+
+console_t * console_create_with_embedded_font(SDL_Window *window, 
+        uint32_t width, uint32_t height, 
+        uint32_t row_count, uint32_t col_count,
+        uint32_t bg_color) {
+
+    // Expand the bitmap to the same white-on-black atlas the font image holds
+    const embedded_font_t *font = &console_embedded_font;
+    SDL_Surface *image = SDL_CreateRGBSurfaceWithFormat(0, (int)font->atlas_width, (int)font->atlas_height, 32, SDL_PIXELFORMAT_ARGB8888);
     if (image == NULL) {
         return NULL;
     }
 
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, image);
-    SDL_FreeSurface(image);
-    if (texture == NULL) {
-        return NULL;
+    SDL_LockSurface(image);
+    for (uint32_t y = 0; y < font->atlas_height; y++) {
+        const uint8_t *bits = &font->bits[y * font->row_bytes];
+        uint32_t *pixels = (uint32_t *)((uint8_t *)image->pixels + ((size_t)y * image->pitch));
+        for (uint32_t x = 0; x < font->atlas_width; x++) {
+            pixels[x] = (bits[x / 8] & (0x80 >> (x % 8))) ? 0xffffffff : 0xff000000;
+        }
     }
+    SDL_UnlockSurface(image);
 
-    // Now that all the SDL stuff has successfully completed, we can
-    // assemble our console
-    console_t *con = calloc(1, sizeof(console_t));
-    con->width = width;
-    con->height = height;
-    con->row_count = row_count;
-    con->col_count = col_count;
-    con->cell_width = width / col_count;
-    con->cell_height = height / row_count;
-    con->bg_color = bg_color;
-    con->renderer = renderer;
-    con->font_texture = texture;
-    
-    return con;
+    return console_create_with_font_surface(window, width, height, row_count, col_count, bg_color, image,
+            font->glyph_width, font->glyph_height);
 }
 
 void console_destroy(console_t *console) {
-    SDL_DestroyTexture(console->font_texture);
+    if (console->native_target != NULL) {
+        SDL_DestroyTexture(console->native_target);
+    }
+    console_font_destroy(console->font);
 	SDL_DestroyRenderer(console->renderer);
     free(console);
 }
 
+void console_set_font(console_t *console, console_font_t *font) {
+    console_font_destroy(console->font);
+    console->font = font;
+
+    // The offscreen grid is sized by the glyphs, so follow the new font
+    if (console->native_target != NULL) {
+        console_create_native_target(console);
+    }
+}
+
 void console_clear(console_t *console) {
     SDL_SetRenderDrawColor(console->renderer, RED(console->bg_color), GREEN(console->bg_color), BLUE(console->bg_color), ALPHA(console->bg_color));
     SDL_RenderClear(console->renderer);
 }
 
 void console_render_screen(console_t *console, console_screen_t *screen) {
-    // Render all cells on the given screen to the given console
-    for (uint32_t y = 0; y < screen->height; y++) {
-        for (uint32_t x = 0; x < screen->width; x++) {
-            console_cell_t *cell = console_screen_cell(screen, x, y);
-            int tex_x = (cell->glyph % 16) * 10;
-            int tex_y = (cell->glyph / 16) * 16;
-            SDL_Rect src_rect = {tex_x, tex_y,  10, 16};
-            SDL_Rect dst_rect = {x*10, y*16, 10, 16};
-
-            SDL_SetTextureColorMod(console->font_texture, RED(cell->fg_color), GREEN(cell->fg_color), BLUE(cell->fg_color));
-            SDL_RenderCopy(console->renderer, console->font_texture, &src_rect, &dst_rect);
+    console_draw_screen(console, screen);
+    console_present(console);
+}
+
+void console_draw_screen(console_t *console, console_screen_t *screen) {
+    const console_font_t *font = console->font;
+
+    // Render all cells on the given screen to the given console, one font page at a time
+    // so each page's texture is bound once per frame however the glyphs are mixed
+    for (uint32_t page = 0; page < font->page_count; page++) {
+        SDL_Texture *texture = font->pages[page];
+        bool have_color = false;
+        uint32_t current_color = 0;
+
+        for (uint32_t y = 0; y < screen->height; y++) {
+            // Nothing drawn on this row since a lazy clear: draw it as cleared, glyph 0 over
+            // the old foreground colors, so it looks the same as after an eager clear
+            bool stale = console_screen_row_stale(screen, y);
+            for (uint32_t x = 0; x < screen->width; x++) {
+                console_cell_t *cell = &screen->cells[(y * screen->width) + x];
+                uint32_t glyph = stale ? 0 : cell->glyph;
+                if (glyph >= font->glyph_count || font->glyphs[glyph].page != page) {
+                    continue;
+                }
+                SDL_Rect dst_rect = {x * console->cell_width, y * console->cell_height, console->cell_width, console->cell_height};
+
+                if (!have_color || cell->fg_color != current_color) {
+                    SDL_SetTextureColorMod(texture, RED(cell->fg_color), GREEN(cell->fg_color), BLUE(cell->fg_color));
+                    current_color = cell->fg_color;
+                    have_color = true;
+                }
+                SDL_RenderCopy(console->renderer, texture, &font->glyphs[glyph].src_rect, &dst_rect);
+            }
         }
     }
+}
+
+void console_present(console_t *console) {
+    if (console->native_target == NULL) {
+        SDL_RenderPresent(console->renderer);
+        return;
+    }
+
+    int target_width, target_height, output_width, output_height;
+    SDL_QueryTexture(console->native_target, NULL, NULL, &target_width, &target_height);
+    SDL_SetRenderTarget(console->renderer, NULL);
+    SDL_GetRendererOutputSize(console->renderer, &output_width, &output_height);
+
+    // Largest whole scale that fits, centred; a window smaller than the grid is just squeezed in
+    int scale = (output_width / target_width < output_height / target_height) ?
+            output_width / target_width : output_height / target_height;
+    SDL_Rect dst_rect = {0, 0, output_width, output_height};
+    if (scale > 0) {
+        dst_rect.w = target_width * scale;
+        dst_rect.h = target_height * scale;
+        dst_rect.x = (output_width - dst_rect.w) / 2;
+        dst_rect.y = (output_height - dst_rect.h) / 2;
+    }
+
+    console_clear(console);
+    SDL_RenderCopy(console->renderer, console->native_target, NULL, &dst_rect);
     SDL_RenderPresent(console->renderer);
+    SDL_SetRenderTarget(console->renderer, console->native_target);
+}
+
+bool console_set_native_scaling(console_t *console, bool enabled) {
+    if (enabled) {
+        return console_create_native_target(console);
+    }
+    if (console->native_target == NULL) {
+        return true;
+    }
+
+    SDL_SetRenderTarget(console->renderer, NULL);
+    SDL_DestroyTexture(console->native_target);
+    console->native_target = NULL;
+    console->cell_width = console->width / console->col_count;
+    console->cell_height = console->height / console->row_count;
+    SDL_RenderSetLogicalSize(console->renderer, console->width, console->height);
+    return true;
+}
+
+
+/* Console Fonts */
+
+console_font_t * console_font_create(SDL_Renderer *renderer, SDL_Surface **pages, uint32_t page_count,
+        uint32_t glyph_width, uint32_t glyph_height) {
+
+    if (page_count == 0 || glyph_width == 0 || glyph_height == 0) {
+        return NULL;
+    }
+
+    console_font_t *font = calloc(1, sizeof(console_font_t));
+    font->glyph_width = glyph_width;
+    font->glyph_height = glyph_height;
+    font->pages = calloc(page_count, sizeof(SDL_Texture *));
+
+    for (uint32_t p = 0; p < page_count; p++) {
+        font->pages[p] = SDL_CreateTextureFromSurface(renderer, pages[p]);
+        if (font->pages[p] == NULL) {
+            console_font_destroy(font);
+            return NULL;
+        }
+        font->page_count += 1;
+        font->glyph_count += (uint32_t)(pages[p]->w / glyph_width) * (uint32_t)(pages[p]->h / glyph_height);
+    }
+
+    // Precompute every glyph's page and source rect, so drawing a cell is a table lookup
+    font->glyphs = calloc(font->glyph_count > 0 ? font->glyph_count : 1, sizeof(console_glyph_t));
+    uint32_t glyph = 0;
+    for (uint32_t p = 0; p < page_count; p++) {
+        uint32_t columns = (uint32_t)pages[p]->w / glyph_width;
+        uint32_t rows = (uint32_t)pages[p]->h / glyph_height;
+        for (uint32_t row = 0; row < rows; row++) {
+            for (uint32_t col = 0; col < columns; col++) {
+                console_glyph_t *entry = &font->glyphs[glyph];
+                entry->src_rect = (SDL_Rect){ (int)(col * glyph_width), (int)(row * glyph_height), (int)glyph_width, (int)glyph_height };
+                entry->page = p;
+                glyph += 1;
+            }
+        }
+    }
+
+    return font;
+}
+
+#ifndef CONSOLE_NO_SDL_IMAGE
+
+console_font_t * console_font_load(SDL_Renderer *renderer, const char **filenames, uint32_t page_count,
+        uint32_t glyph_width, uint32_t glyph_height) {
+
+    SDL_Surface **pages = calloc(page_count > 0 ? page_count : 1, sizeof(SDL_Surface *));
+    console_font_t *font = NULL;
+    uint32_t loaded = 0;
+    for (; loaded < page_count; loaded++) {
+        pages[loaded] = IMG_Load(filenames[loaded]);
+        if (pages[loaded] == NULL) {
+            break;
+        }
+    }
+    if (loaded == page_count) {
+        font = console_font_create(renderer, pages, page_count, glyph_width, glyph_height);
+    }
+
+    for (uint32_t p = 0; p < loaded; p++) {
+        SDL_FreeSurface(pages[p]);
+    }
+    free(pages);
+
+    return font;
+}
+
+#endif
+
+void console_font_destroy(console_font_t *font) {
+    if (font == NULL) {
+        return;
+    }
+    for (uint32_t p = 0; p < font->page_count; p++) {
+        SDL_DestroyTexture(font->pages[p]);
+    }
+    free(font->pages);
+    free(font->glyphs);
+    free(font);
 }
 
 
@@ -101,11 +305,22 @@ console_screen_t * console_screen_create(uint32_t width, uint32_t height, uint32
 }
 
 void console_screen_destroy(console_screen_t *screen) {
+    free(screen->row_generations);
     free(screen->cells);
     free(screen);
 }
 
 void console_screen_clear(console_screen_t *screen) {
+    if (screen->row_generations != NULL) {
+        screen->generation += 1;
+        if (screen->generation == 0) {
+            // Wrapped: rows stamped long ago would look current again, so restamp them all as stale
+            memset(screen->row_generations, 0, screen->height * sizeof(uint32_t));
+            screen->generation = 1;
+        }
+        return;
+    }
+
     uint32_t cell_count = screen->width * screen->height;
     for (uint32_t idx = 0; idx < cell_count; idx++) {
         screen->cells[idx].glyph = 0;
@@ -113,10 +328,56 @@ void console_screen_clear(console_screen_t *screen) {
     }
 }
 
-console_cell_t *console_screen_cell(const console_screen_t *screen, const uint32_t x, const uint32_t y) {
+void console_screen_set_lazy_clear(console_screen_t *screen, bool enabled) {
+    if (enabled == (screen->row_generations != NULL)) {
+        return;
+    }
+
+    if (enabled) {
+        // Whatever is on the screen now stays current until the next clear
+        screen->row_generations = malloc(screen->height * sizeof(uint32_t));
+        screen->generation = 1;
+        for (uint32_t y = 0; y < screen->height; y++) {
+            screen->row_generations[y] = 1;
+        }
+        return;
+    }
+
+    for (uint32_t y = 0; y < screen->height; y++) {
+        console_screen_refresh_row(screen, y);
+    }
+    free(screen->row_generations);
+    screen->row_generations = NULL;
+}
+
+console_cell_t *console_screen_cell(console_screen_t *screen, const uint32_t x, const uint32_t y) {
+    console_screen_refresh_row(screen, y);
     return &screen->cells[(y * screen->width) + x];
 }
 
+void console_screen_copy_rows(const console_screen_t *screen, uint32_t first_row, uint32_t row_count, console_cell_t *cells) {
+    for (uint32_t y = first_row; y < first_row + row_count; y++) {
+        const console_cell_t *row = &screen->cells[y * screen->width];
+        if (!console_screen_row_stale(screen, y)) {
+            memcpy(cells, row, screen->width * sizeof(console_cell_t));
+        } else {
+            for (uint32_t x = 0; x < screen->width; x++) {
+                cells[x] = (console_cell_t){ 0, row[x].fg_color, screen->bg_color };
+            }
+        }
+        cells += screen->width;
+    }
+}
+
+void console_screen_touch_rows(console_screen_t *screen, uint32_t first_row, uint32_t row_count) {
+    if (screen->row_generations == NULL) {
+        return;
+    }
+    for (uint32_t y = first_row; y < first_row + row_count; y++) {
+        screen->row_generations[y] = screen->generation;
+    }
+}
+
 typedef struct {
     uint32_t start_idx;
     uint32_t length;
@@ -152,52 +413,129 @@ text_span_t text_get_next_word(const char *text, int32_t start_idx) {
     return span;
 }
 
-void console_screen_put_text_at(console_screen_t *screen, const char *text, console_rect_t rect, uint32_t fg_color, uint32_t bg_color) {
-    console_point_t curr_point = {rect.x, rect.y};
-    int32_t idx = 0;
-    text_span_t span = text_get_next_word(text, idx);
-    while (span.length > 0) {
-        bool add_space = true;
-
-        if (span.length > rect.width) { return; }
-        
-        // Write the next word to the console, wrapping if necessary
-        if ((curr_point.x + span.length) > (rect.x + rect.width)) {
-            // Wrap to next line
-            curr_point.x = rect.x;
-            curr_point.y += 1;
+typedef struct {
+    uint32_t start_idx;     // offset of the first word on the line
+    uint32_t end_idx;       // offset just past the last word on the line
+    uint32_t length;        // cells covered by the words and the single spaces between them
+    bool trailing_space;    // a space cell follows the last word (more text follows and there's room)
+    bool truncated;         // layout stopped at a word wider than the wrap width
+} text_line_t;
+
+/*
+ * Lay out the line of text that begins at start_idx, wrapping words at the given width.
+ * Words are separated by a single space however much whitespace separates them in the text.
+ * Returns false when there is no line to lay out, either because the text is exhausted or
+ * because the next word can never fit (in which case line->truncated is set).
+ *
+ * This is the single source of the word-wrap rules: both rendering and measurement use it.
+ */
+static
+bool text_next_line(const char *text, uint32_t start_idx, uint32_t width, text_line_t *line) {
+    text_span_t span = text_get_next_word(text, start_idx);
+    line->start_idx = span.start_idx;
+    line->end_idx = span.start_idx;
+    line->length = 0;
+    line->trailing_space = false;
+    line->truncated = false;
+
+    if (span.length == 0) { return false; }
+    if (span.length > width) {
+        line->truncated = true;
+        return false;
+    }
+    line->length = span.length;
+    line->end_idx = span.start_idx + span.length;
+
+    while (1) {
+        span = text_get_next_word(text, line->end_idx);
+        if (span.length == 0) { return true; }
+
+        if (span.length > width || (line->length + 1 + span.length) > width) {
+            line->trailing_space = (line->length < width);
+            line->truncated = (span.length > width);
+            return true;
         }
+        line->length += 1 + span.length;
+        line->end_idx = span.start_idx + span.length;
+    }
+}
 
-        idx = span.start_idx;
-        if (curr_point.y < (rect.y + rect.height)) {
+void console_screen_put_text_at(console_screen_t *screen, const char *text, console_rect_t rect, uint32_t fg_color, uint32_t bg_color) {
+    text_line_t line;
+    uint32_t idx = 0;
+    for (uint32_t row = 0; row < rect.height; row++) {
+        if (!text_next_line(text, idx, rect.width, &line)) { return; }
+
+        // Write the words on this line, separated by single spaces
+        console_cell_t *cells = console_screen_cell(screen, rect.x, rect.y + row);
+        uint32_t x = 0;
+        text_span_t span = text_get_next_word(text, line.start_idx);
+        while (span.length > 0 && span.start_idx < line.end_idx) {
+            if (x > 0) {
+                console_cell_t spc = { 0, fg_color, bg_color };
+                cells[x] = spc;
+                x += 1;
+            }
             for (uint32_t i = 0; i < span.length; i++) {
-                char c = text[idx + i];
-                console_cell_t cell = {c, fg_color, bg_color};
-                console_screen_set_cell(screen, curr_point.x + i, curr_point.y, cell);
+                console_cell_t cell = {(uint8_t)text[span.start_idx + i], fg_color, bg_color};
+                cells[x + i] = cell;
             }
-            curr_point.x += span.length;
+            x += span.length;
+            span = text_get_next_word(text, span.start_idx + span.length);
         }
 
-        // Grab the span for the next word, if there is one
-        idx = span.start_idx + span.length;
-        span = text_get_next_word(text, idx);
-        if (span.length == 0) { add_space = false; }
-
-        // Add a space after the word we just wrote, if warranted and there's room
-        if (add_space && curr_point.x < (rect.x + rect.width)) {
+        if (line.trailing_space) {
             console_cell_t spc = { 0, fg_color, bg_color };
-            console_screen_set_cell(screen, curr_point.x, curr_point.y, spc);
-            curr_point.x += 1;
+            cells[x] = spc;
         }
+        if (line.truncated) { return; }
+
+        idx = line.end_idx;
     }
 }
 
+console_text_metrics_t console_text_measure(const char *text, uint32_t width, uint32_t *line_breaks, uint32_t max_breaks) {
+    console_text_metrics_t metrics = {0, 0, false};
+    text_line_t line;
+    uint32_t idx = 0;
+    while (text_next_line(text, idx, width, &line)) {
+        if (line_breaks != NULL && metrics.line_count < max_breaks) {
+            line_breaks[metrics.line_count] = line.start_idx;
+        }
+        metrics.line_count += 1;
+        if (line.length > metrics.widest_line) {
+            metrics.widest_line = line.length;
+        }
+        if (line.truncated) { break; }
+
+        idx = line.end_idx;
+    }
+    metrics.truncated = line.truncated;
+
+    return metrics;
+}
+
+void console_screen_printf_at(console_screen_t *screen, console_rect_t rect, uint32_t fg_color, uint32_t bg_color, const char *format, ...) {
+    char text[CONSOLE_PRINTF_MAX_LENGTH];
+
+    va_list argp;
+    va_start(argp, format);
+    int len = vsnprintf(text, sizeof(text), format, argp);
+    va_end(argp);
+    if (len < 0) {
+        return;
+    }
+
+    console_screen_put_text_at(screen, text, rect, fg_color, bg_color);
+}
+
 void console_screen_put_view_at(console_screen_t *screen, console_view_t *view, uint32_t x, uint32_t y) {
     console_rect_t rect = {x, y, view->width, view->height};
     console_screen_set_cells(screen, &rect, view->cells);
 }
 
 void console_screen_set_cell(console_screen_t *screen, uint32_t x, uint32_t y, console_cell_t cell) {
+    console_screen_refresh_row(screen, y);
     screen->cells[(y * screen->width) + x] = cell;
 }
 
@@ -206,6 +544,9 @@ void console_screen_set_cells(console_screen_t *screen, console_rect_t *rect, co
     for (uint32_t cell_idx = 0; cell_idx < cell_count; cell_idx++) {
         uint32_t x = rect->x + (cell_idx % rect->width);
         uint32_t y = rect->y + (cell_idx / rect->width);
+        if (x == rect->x) {
+            console_screen_refresh_row(screen, y);
+        }
         screen->cells[(y * screen->width) + x] = cells[cell_idx];
     }
 }
@@ -214,60 +555,586 @@ void console_screen_set_cells(console_screen_t *screen, console_rect_t *rect, co
 /* Console Views */
 
 console_view_t *console_view_from_rexfile(const char *filename) {
-    rex_tile_map_t *map = rex_load_tile_map(filename);
-    if (!map) {
+    rex_stream_t *stream = rex_stream_open(filename);
+    if (!stream) {
         return NULL;
     }
 
-    rex_tile_layer_t *layer = rex_flatten_tile_map(map);
-    if (!layer) {
+    console_view_t *view = console_view_from_rex_stream(stream);
+    rex_stream_close(stream);
+
+    return view;
+}
+
+console_view_t *console_view_from_rexdata(const void *data, size_t size) {
+    rex_stream_t *stream = rex_stream_open_memory(data, size);
+    if (!stream) {
         return NULL;
     }
 
-    console_view_t *v = calloc(1, sizeof(console_view_t));
-    v->width = layer->width;
-    v->height = layer->height;
-    uint32_t tile_count = v->width * v->height;
-    v->cells = calloc(tile_count, sizeof(console_cell_t));
-
-    for (uint32_t t = 0; t < tile_count; t++) {
-        uint32_t cell_idx = view_cell_index_for_rex_index(t, layer->width, layer->height);
-        console_cell_t *cell = &v->cells[cell_idx];
-        rex_tile_t tile = layer->tiles[t];
-        cell->glyph = tile.char_code;
-        if (!rex_tile_is_transparent(&tile)) {
-            cell->fg_color = COLOR_FROM_RGBA(tile.fg_red, tile.fg_green, tile.fg_blue, 255);
-            cell->bg_color = COLOR_FROM_RGBA(tile.bg_red, tile.bg_green, tile.bg_blue, 255);
-        } else {
-            // Transparent tile
-            cell->fg_color = COLOR_FROM_RGBA(tile.fg_red, tile.fg_green, tile.fg_blue, 255);
-            cell->bg_color = COLOR_FROM_RGBA(0, 0, 0, 0);
+    console_view_t *view = console_view_from_rex_stream(stream);
+    rex_stream_close(stream);
+
+    return view;
+}
+
+console_view_t *console_view_from_rex_region(const rex_index_t *index, console_rect_t rect) {
+    uint32_t height = rex_index_height(index);
+    if (rect.width == 0 || rect.height == 0 || rect.y >= height || rect.height > height - rect.y) {
+        return NULL;
+    }
+
+    size_t cell_count = (size_t)rect.width * rect.height;
+    console_cell_t *cells = malloc(cell_count * sizeof(console_cell_t));
+    if (!cells) {
+        return NULL;
+    }
+
+    // Regions are whole columns; the rows outside the rect are cropped while folding
+    for (uint32_t l = 0; l < rex_index_layer_count(index); l++) {
+        rex_tile_layer_t *region = rex_load_region(index, l, rect.x, rect.width);
+        if (!region) {
+            free(cells);
+            return NULL;
         }
+        view_cells_fold_rex_columns(cells, rect.width, rect.height, region->tiles + rect.y, height, 0, rect.width, (l == 0));
+        rex_destroy_tile_layer(region);
     }
-    
-    rex_destroy_tile_map(map);
+    view_cells_fill_blanks(cells, cell_count);
+
+    console_view_t *v = calloc(1, sizeof(console_view_t));
+    v->width = rect.width;
+    v->height = rect.height;
+    v->cells = cells;
 
     return v;
 }
 
 void console_view_destroy(console_view_t *view) {
-    free(view->cells);
+    if (view->mapping != NULL) {
+        munmap(view->mapping, view->mapping_size);
+    } else {
+        free(view->cells);
+    }
     free(view);
 }
 
+void console_view_touch(console_view_t *view) {
+    view->version += 1;
+}
+
+bool console_view_set_cell(console_view_t *view, uint32_t x, uint32_t y, console_cell_t cell) {
+    // Mapped cells are read-only pages; writing them would fault
+    if (view->mapping != NULL) {
+        return false;
+    }
+    view->cells[(y * view->width) + x] = cell;
+    view->version += 1;
+    return true;
+}
+
+
+/* Layered Views */
+
+console_layered_view_t *console_layered_view_from_rexfile(const char *filename) {
+    rex_stream_t *stream = rex_stream_open(filename);
+    if (!stream) {
+        return NULL;
+    }
+
+    uint32_t window_columns;
+    rex_tile_t *window = view_stream_window(stream, &window_columns);
+    if (!window) {
+        rex_stream_close(stream);
+        return NULL;
+    }
+
+    console_layered_view_t *layered = calloc(1, sizeof(console_layered_view_t));
+    layered->width = rex_stream_width(stream);
+    layered->height = rex_stream_height(stream);
+    layered->layer_count = rex_stream_layer_count(stream);
+    layered->layers = calloc(layered->layer_count, sizeof(console_cell_t *));
+    layered->composites = list_create(NULL);
+
+    size_t cell_count = (size_t)layered->width * layered->height;
+    for (uint32_t l = 0; l < layered->layer_count; l++) {
+        layered->layers[l] = malloc(cell_count * sizeof(console_cell_t));
+        if (!layered->layers[l] || !view_cells_read_rex_layer(stream, layered->layers[l], window, window_columns, true)) {
+            goto error;
+        }
+    }
+    if (!rex_stream_finish(stream)) {
+        goto error;
+    }
+
+    free(window);
+    rex_stream_close(stream);
+
+    return layered;
+
+error:
+    free(window);
+    rex_stream_close(stream);
+    console_layered_view_destroy(layered);
+    return NULL;
+}
+
+void console_layered_view_destroy(console_layered_view_t *layered) {
+    while (list_count(layered->composites) > 0) {
+        console_layer_composite_t *composite = list_remove_first(layered->composites);
+        console_view_destroy(composite->view);
+        free(composite);
+    }
+    list_destroy(layered->composites);
+
+    for (uint32_t l = 0; l < layered->layer_count; l++) {
+        free(layered->layers[l]);
+    }
+    free(layered->layers);
+    free(layered);
+}
+
+console_view_t *console_layered_view_composite(console_layered_view_t *layered, uint32_t layer_mask) {
+    layer_mask &= (uint32_t)(((uint64_t)1 << layered->layer_count) - 1);
+
+    console_view_t *view = layered_view_find_composite(layered, layer_mask);
+    if (view != NULL) {
+        return view;
+    }
+
+    console_cell_t *cells = malloc((size_t)layered->width * layered->height * sizeof(console_cell_t));
+    if (!cells) {
+        return NULL;
+    }
+    console_rect_t rect = {0, 0, layered->width, layered->height};
+    console_layered_view_composite_rect(layered, layer_mask, rect, cells);
+
+    view = calloc(1, sizeof(console_view_t));
+    view->width = layered->width;
+    view->height = layered->height;
+    view->cells = cells;
+
+    console_layer_composite_t *composite = calloc(1, sizeof(console_layer_composite_t));
+    composite->layer_mask = layer_mask;
+    composite->view = view;
+    list_append(layered->composites, composite);
+
+    return view;
+}
+
+void console_layered_view_composite_rect(console_layered_view_t *layered, uint32_t layer_mask, console_rect_t rect, console_cell_t *cells) {
+    static const console_cell_t blank_cell = {0, COLOR_FROM_RGBA(0, 0, 0, 255), COLOR_FROM_RGBA(0, 0, 0, 255)};
+
+    // Gather the selected layers once, rather than testing the mask for every cell
+    const console_cell_t *selected[REX_MAX_LAYERS];
+    uint32_t selected_count = 0;
+    for (uint32_t l = 0; l < layered->layer_count; l++) {
+        if (layer_mask & (1u << l)) {
+            selected[selected_count] = layered->layers[l];
+            selected_count += 1;
+        }
+    }
+
+    for (uint32_t y = 0; y < rect.height; y++) {
+        size_t row_start = ((size_t)(rect.y + y) * layered->width) + rect.x;
+        console_cell_t *out = &cells[(size_t)y * rect.width];
+        for (uint32_t x = 0; x < rect.width; x++) {
+            const console_cell_t *cell = &blank_cell;
+            for (uint32_t l = 0; l < selected_count; l++) {
+                if (ALPHA(selected[l][row_start + x].bg_color) != 0) {
+                    cell = &selected[l][row_start + x];
+                    break;
+                }
+            }
+            out[x] = *cell;
+        }
+    }
+}
+
 
 // Internal Functions --
 
 /*
- * Return the corresponding index of the cell in the console image cell array for the given index in the
- * rex_tile_layer tile array. The console image will be stored in row-major order, while the rex_layer data
- * is stored in column-major order. 
+ * Finish creating a console once the font atlas image is loaded. Takes ownership of the image.
  */
-static 
-uint32_t view_cell_index_for_rex_index(const uint32_t rex_idx, const uint32_t width, const uint32_t height) {
-    uint32_t row = rex_idx % height;
-    uint32_t col = rex_idx / height;
-    return (row * width) + col;
+static
+console_t * console_create_with_font_surface(SDL_Window *window, 
+        uint32_t width, uint32_t height, 
+        uint32_t row_count, uint32_t col_count,
+        uint32_t bg_color, SDL_Surface *image,
+        uint32_t glyph_width, uint32_t glyph_height) {
+
+    if (image == NULL) {
+        return NULL;
+    }
+
+	SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    if (renderer == NULL) {
+        SDL_FreeSurface(image);
+        return NULL;
+    }
+	SDL_RenderSetLogicalSize(renderer, width, height);
+
+    console_font_t *font = console_font_create(renderer, &image, 1, glyph_width, glyph_height);
+    SDL_FreeSurface(image);
+    if (font == NULL) {
+        SDL_DestroyRenderer(renderer);
+        return NULL;
+    }
+
+    // Now that all the SDL stuff has successfully completed, we can
+    // assemble our console
+    console_t *con = calloc(1, sizeof(console_t));
+    con->width = width;
+    con->height = height;
+    con->row_count = row_count;
+    con->col_count = col_count;
+    con->cell_width = width / col_count;
+    con->cell_height = height / row_count;
+    con->bg_color = bg_color;
+    con->renderer = renderer;
+    con->font = font;
+    
+    return con;
+}
+
+/*
+ * Whether the row hasn't been written since the last lazy clear.
+ */
+static
+bool console_screen_row_stale(const console_screen_t *screen, uint32_t y) {
+    return screen->row_generations != NULL && screen->row_generations[y] != screen->generation;
+}
+
+/*
+ * Before a row of a lazily cleared screen is written, do the clearing that was put off.
+ */
+static
+void console_screen_refresh_row(console_screen_t *screen, uint32_t y) {
+    if (!console_screen_row_stale(screen, y)) {
+        return;
+    }
+
+    console_cell_t *row = &screen->cells[y * screen->width];
+    for (uint32_t x = 0; x < screen->width; x++) {
+        row[x].glyph = 0;
+        row[x].bg_color = screen->bg_color;
+    }
+    screen->row_generations[y] = screen->generation;
+}
+
+/*
+ * (Re)create the offscreen texture for native scaling at the current font's resolution
+ * and make it the render target.
+ */
+static
+bool console_create_native_target(console_t *console) {
+    uint32_t glyph_width = console->font->glyph_width;
+    uint32_t glyph_height = console->font->glyph_height;
+
+    // Scale quality is fixed when a texture is created; the one upscale must stay crisp.
+    // The hint is process-wide, so put back whatever the game had set once we're done
+    const char *quality = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    char *previous_quality = (quality != NULL) ? SDL_strdup(quality) : NULL;
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+    SDL_Texture *target = SDL_CreateTexture(console->renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+            (int)(console->col_count * glyph_width), (int)(console->row_count * glyph_height));
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, previous_quality);
+    SDL_free(previous_quality);
+    if (target == NULL) {
+        return false;
+    }
+
+    if (console->native_target != NULL) {
+        SDL_DestroyTexture(console->native_target);
+    }
+    console->native_target = target;
+    console->cell_width = glyph_width;
+    console->cell_height = glyph_height;
+
+    // The final copy places itself in real output pixels, so SDL mustn't rescale it again
+    SDL_SetRenderTarget(console->renderer, NULL);
+    SDL_RenderSetLogicalSize(console->renderer, 0, 0);
+    SDL_SetRenderTarget(console->renderer, target);
+    return true;
 }
 
+/*
+ * Build a composited view from an open stream, one window of columns at a time, so the
+ * whole tile map is never held in memory.
+ */
+static
+console_view_t * console_view_from_rex_stream(rex_stream_t *stream) {
+    uint32_t width = rex_stream_width(stream);
+    uint32_t height = rex_stream_height(stream);
+    size_t cell_count = (size_t)width * height;
+
+    uint32_t window_columns;
+    rex_tile_t *window = view_stream_window(stream, &window_columns);
+    console_cell_t *cells = malloc(cell_count * sizeof(console_cell_t));
+    if (!window || !cells) {
+        goto error;
+    }
+
+    for (uint32_t l = 0; l < rex_stream_layer_count(stream); l++) {
+        if (!view_cells_read_rex_layer(stream, cells, window, window_columns, (l == 0))) {
+            goto error;
+        }
+    }
+    if (!rex_stream_finish(stream)) {
+        goto error;
+    }
+    free(window);
+    view_cells_fill_blanks(cells, cell_count);
+
+    console_view_t *v = calloc(1, sizeof(console_view_t));
+    v->width = width;
+    v->height = height;
+    v->cells = cells;
+
+    return v;
+
+error:
+    free(window);
+    free(cells);
+    return NULL;
+}
+
+/*
+ * Read the stream's next layer through the tile window and fold it into the cells.
+ */
+static
+bool view_cells_read_rex_layer(rex_stream_t *stream, console_cell_t *cells, rex_tile_t *window, uint32_t window_columns, bool first_layer) {
+    uint32_t width = rex_stream_width(stream);
+    uint32_t height = rex_stream_height(stream);
+
+    if (!rex_stream_next_layer(stream)) {
+        return false;
+    }
+    for (uint32_t column = 0; column < width; column += window_columns) {
+        uint32_t column_count = (column + window_columns < width) ? window_columns : width - column;
+        if (!rex_stream_read_tiles(stream, window, (uint64_t)column_count * height)) {
+            return false;
+        }
+        view_cells_fold_rex_columns(cells, width, height, window, height, column, column_count, first_layer);
+    }
+    return true;
+}
+
+/*
+ * Fold a run of REX columns into row-major console cells. Each column holds height tiles,
+ * tile_stride apart (so rows can be cropped off the bottom and, by offsetting tiles, the top).
+ * The tiles are stored in column-major order, so the transposition is done in square blocks
+ * to keep both the tile reads and the cell writes within a few cache lines.
+ *
+ * For the first layer every tile is written, with transparent tiles kept as cells with a fully
+ * transparent background. Later layers only fill cells that are still transparent, so each
+ * cell ends up with the first non-transparent tile found walking from layer 0 upwards.
+ */
+static
+void view_cells_fold_rex_columns(console_cell_t *cells, uint32_t width, uint32_t height, const rex_tile_t *tiles, uint32_t tile_stride, uint32_t first_column, uint32_t column_count, bool first_layer) {
+    for (uint32_t block_y = 0; block_y < height; block_y += VIEW_TRANSPOSE_BLOCK_SIZE) {
+        uint32_t end_y = (block_y + VIEW_TRANSPOSE_BLOCK_SIZE < height) ? block_y + VIEW_TRANSPOSE_BLOCK_SIZE : height;
+        for (uint32_t block_x = 0; block_x < column_count; block_x += VIEW_TRANSPOSE_BLOCK_SIZE) {
+            uint32_t end_x = (block_x + VIEW_TRANSPOSE_BLOCK_SIZE < column_count) ? block_x + VIEW_TRANSPOSE_BLOCK_SIZE : column_count;
+
+            for (uint32_t x = block_x; x < end_x; x++) {
+                for (uint32_t y = block_y; y < end_y; y++) {
+                    const rex_tile_t *tile = &tiles[((size_t)x * tile_stride) + y];
+                    console_cell_t *cell = &cells[((size_t)y * width) + first_column + x];
+                    bool transparent = rex_tile_is_transparent(tile);
+                    if (!first_layer && (transparent || ALPHA(cell->bg_color) != 0)) {
+                        continue;
+                    }
+
+                    cell->glyph = tile->char_code;
+                    cell->fg_color = COLOR_FROM_RGBA(tile->fg_red, tile->fg_green, tile->fg_blue, 255);
+                    cell->bg_color = transparent ? COLOR_FROM_RGBA(0, 0, 0, 0) : COLOR_FROM_RGBA(tile->bg_red, tile->bg_green, tile->bg_blue, 255);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Cells that are transparent in every layer come out as an opaque black blank,
+ * as with rex_flatten_tile_map.
+ */
+static
+void view_cells_fill_blanks(console_cell_t *cells, size_t cell_count) {
+    static const console_cell_t blank_cell = {0, COLOR_FROM_RGBA(0, 0, 0, 255), COLOR_FROM_RGBA(0, 0, 0, 255)};
+
+    for (size_t i = 0; i < cell_count; i++) {
+        if (ALPHA(cells[i].bg_color) == 0) {
+            cells[i] = blank_cell;
+        }
+    }
+}
+
+/*
+ * Allocate the tile window used to stream the given file: as many whole columns as fit in
+ * VIEW_STREAM_WINDOW_SIZE, but never less than one.
+ */
+static
+rex_tile_t * view_stream_window(rex_stream_t *stream, uint32_t *window_columns) {
+    uint32_t height = rex_stream_height(stream);
+    size_t column_size = (size_t)height * sizeof(rex_tile_t);
+    size_t columns = VIEW_STREAM_WINDOW_SIZE / column_size;
+    if (columns < 1) { columns = 1; }
+    if (columns > rex_stream_width(stream)) { columns = rex_stream_width(stream); }
+
+    *window_columns = (uint32_t)columns;
+    return malloc(columns * column_size);
+}
+
+/*
+ * Return the cached composite for the given layer mask, or NULL if it hasn't been built yet.
+ */
+static
+console_view_t * layered_view_find_composite(console_layered_view_t *layered, uint32_t layer_mask) {
+    console_view_t *found = NULL;
+    list_iterator_t *iter = list_iterator(layered->composites);
+    while (list_iterator_next(iter)) {
+        console_layer_composite_t *composite = list_iterator_data(iter);
+        if (composite->layer_mask == layer_mask) {
+            found = composite->view;
+            break;
+        }
+    }
+    list_iterator_destroy(iter);
+
+    return found;
+}
+
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <sys/resource.h>
+#include <time.h>
+#include <zlib.h>
+
+#define TEST_MAP_WIDTH      2000
+#define TEST_MAP_HEIGHT     2000
+#define TEST_MAP_LAYERS     4
+
+static
+long peak_rss_bytes(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024L;
+#endif
+}
+
+static
+double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1e6);
+}
+
+// Draw the same small amount onto an eagerly and a lazily cleared screen and compare them
+static
+bool lazy_clear_matches(console_screen_t *eager, console_screen_t *lazy, uint32_t frame) {
+    console_screen_t *screens[2] = { eager, lazy };
+    for (uint32_t i = 0; i < 2; i++) {
+        console_screen_clear(screens[i]);
+        console_rect_t rect = { frame % 50, (frame * 7) % (screens[i]->height - 2), 30, 2 };
+        console_screen_printf_at(screens[i], rect, 0xffffffff, 0x000000ff, "frame %u of the lazy clear test", frame);
+        console_screen_set_cell(screens[i], 3, (frame * 3) % screens[i]->height, (console_cell_t){ '@', 0xff0000ff, 0 });
+    }
+
+    size_t cells_size = (size_t)lazy->width * lazy->height * sizeof(console_cell_t);
+    console_cell_t *resolved = malloc(cells_size);
+    console_screen_copy_rows(lazy, 0, lazy->height, resolved);
+    bool match = memcmp(resolved, eager->cells, cells_size) == 0;
+    free(resolved);
+    return match;
+}
+
+int main() {
+    // Lazy clearing: the same drawing reads back the same, including across a generation wrap
+    console_screen_t *eager = console_screen_create(400, 200, 0x102030ff);
+    console_screen_t *lazy = console_screen_create(400, 200, 0x102030ff);
+    console_screen_set_lazy_clear(lazy, true);
+    bool lazy_ok = true;
+    for (uint32_t frame = 0; frame < 100; frame++) {
+        if (frame == 50) {
+            lazy->generation = UINT32_MAX - 1;
+        }
+        lazy_ok = lazy_ok && lazy_clear_matches(eager, lazy, frame);
+    }
+
+    double timings[2];
+    console_screen_t *screens[2] = { eager, lazy };
+    for (uint32_t i = 0; i < 2; i++) {
+        double start = now_ms();
+        for (uint32_t frame = 0; frame < 1000; frame++) {
+            console_screen_clear(screens[i]);
+            console_screen_printf_at(screens[i], (console_rect_t){ 0, frame % 200, 40, 1 }, 0xffffffff, 0, "frame %u", frame);
+        }
+        timings[i] = now_ms() - start;
+    }
+    printf("Lazy clear matches eager clear: %s; 1000 clears of 400x200 plus a line: eager %.2f ms, lazy %.2f ms\n",
+            lazy_ok ? "yes" : "NO", timings[0], timings[1]);
+    console_screen_destroy(lazy);
+    console_screen_destroy(eager);
+
+    const char *filename = "/tmp/console_stream_test.xp";
+
+    // Write a map far larger than the streaming window, a column at a time
+    gzFile file = gzopen(filename, "wb1");
+    int32_t version = -1;
+    uint32_t layer_count = TEST_MAP_LAYERS, width = TEST_MAP_WIDTH, height = TEST_MAP_HEIGHT;
+    gzwrite(file, &version, sizeof(version));
+    gzwrite(file, &layer_count, sizeof(layer_count));
+    rex_tile_t column[TEST_MAP_HEIGHT];
+    for (uint32_t l = 0; l < layer_count; l++) {
+        gzwrite(file, &width, sizeof(width));
+        gzwrite(file, &height, sizeof(height));
+        for (uint32_t x = 0; x < width; x++) {
+            for (uint32_t y = 0; y < height; y++) {
+                // Layer l is opaque on every (l + 2)th row and the last layer everywhere, so lower layers show through
+                bool opaque = (l == layer_count - 1) || (y % (l + 2) == 0);
+                column[y] = (rex_tile_t){ .char_code = 'a' + l, .fg_red = 255, .fg_green = 255, .fg_blue = 255,
+                    .bg_red = opaque ? (uint8_t)l : 255, .bg_green = 0, .bg_blue = opaque ? 0 : 255 };
+            }
+            gzwrite(file, column, sizeof(column));
+        }
+    }
+    gzclose(file);
+
+    size_t view_size = (size_t)TEST_MAP_WIDTH * TEST_MAP_HEIGHT * sizeof(console_cell_t);
+    size_t map_size = (size_t)TEST_MAP_WIDTH * TEST_MAP_HEIGHT * TEST_MAP_LAYERS * sizeof(rex_tile_t);
+
+    long before = peak_rss_bytes();
+    console_view_t *view = console_view_from_rexfile(filename);
+    long growth = peak_rss_bytes() - before;
+    if (!view) {
+        printf("Load failed: %s\n", rex_get_error());
+        return 1;
+    }
+
+    // Row 0 is opaque in layer 0; row 1 only in the last layer; row 3 first in layer 1
+    bool layers_ok = view->cells[0].glyph == 'a' && view->cells[view->width].glyph == 'd' &&
+        view->cells[3 * view->width].glyph == 'b';
+
+    printf("Composited layers: %s\n", layers_ok ? "ok" : "WRONG");
+    printf("Peak memory growth: %.1f MB (view %.1f MB, whole tile map %.1f MB)\n",
+            growth / 1048576.0, view_size / 1048576.0, map_size / 1048576.0);
+    bool bounded = (size_t)growth <= view_size + (8 * 1024 * 1024);
+    printf("Peak memory bounded by the view: %s\n", bounded ? "yes" : "NO");
+
+    console_view_destroy(view);
+    remove(filename);
+
+    return (lazy_ok && layers_ok && bounded) ? 0 : 1;
+}
 
+#endif
@@ -2,10 +2,12 @@
 #define CONSOLE_H
 
 
+#include <stddef.h>
 #include <stdint.h>
 #include <SDL2/SDL.h>
 
 #include "list.h"
+#include "rex_loader.h"
 
 
 // Helper macros for working with pixel colors
@@ -16,6 +18,13 @@
 
 #define COLOR_FROM_RGBA(r, g, b, a) ((r << 24) | (g << 16) | (b << 8) | a)
 
+// Longest formatted string console_screen_printf_at will draw; longer output is truncated
+#define CONSOLE_PRINTF_MAX_LENGTH 512
+
+// Glyph size of font atlas images loaded by console_create / console_create_from_font_data
+#define CONSOLE_DEFAULT_GLYPH_WIDTH     10
+#define CONSOLE_DEFAULT_GLYPH_HEIGHT    16
+
 
 typedef struct {
     uint32_t x;
@@ -40,16 +49,56 @@ typedef struct {
     uint32_t width;
     uint32_t height;
     console_cell_t *cells;
+    void *mapping;          // non-NULL when cells point into a read-only file mapping (see view_file.h);
+                            // such cells must never be written, so copy the view to change it
+    size_t mapping_size;
+    uint32_t version;       // bumped by console_view_touch whenever the cells change
 } console_view_t;
 
+typedef struct {
+    uint32_t layer_mask;
+    console_view_t *view;
+} console_layer_composite_t;
+
+typedef struct {
+    /* All values measured in cells */
+    uint32_t width;
+    uint32_t height;
+    uint32_t layer_count;
+    console_cell_t **layers;    // one row-major cell array per layer; transparent cells have a bg alpha of 0
+    list_t *composites;         // console_layer_composite_t, built on demand and cached per layer mask
+} console_layered_view_t;
+
 typedef struct {
     /* All values measured in cells */
     uint32_t width;     
     uint32_t height;    
     uint32_t bg_color;
     console_cell_t *cells;
+    uint32_t *row_generations;  // lazy clearing: generation each row was last written in, NULL when off
+    uint32_t generation;
 } console_screen_t;
 
+typedef struct {
+    uint32_t line_count;
+    uint32_t widest_line;   // cells, not counting the space left at the end of a wrapped line
+    bool truncated;         // a word wider than the wrap width stopped the layout early
+} console_text_metrics_t;
+
+typedef struct {
+    SDL_Rect src_rect;      // where the glyph sits on its page
+    uint32_t page;
+} console_glyph_t;
+
+typedef struct {
+    uint32_t glyph_width;       // pixels
+    uint32_t glyph_height;      // pixels
+    uint32_t glyph_count;
+    uint32_t page_count;
+    SDL_Texture **pages;
+    console_glyph_t *glyphs;    // indexed by glyph code; built when the font is created
+} console_font_t;
+
 typedef struct {
     uint32_t width;         // pixels
     uint32_t height;        // pixels
@@ -59,7 +108,8 @@ typedef struct {
     uint32_t cell_height;   // pixels
     uint32_t bg_color;
     SDL_Renderer *renderer;
-    SDL_Texture *font_texture;
+    console_font_t *font;
+    SDL_Texture *native_target; // grid drawn at font resolution, when native scaling is on
 } console_t;
 
 
@@ -70,12 +120,82 @@ console_t * console_create(SDL_Window *window,
         uint32_t row_count, uint32_t col_count,
         uint32_t bg_color, const char *font_filename);
 
+/*
+ * Create a console whose font atlas is read from an image already in memory
+ * (for example an entry in an asset archive) rather than from a file.
+ * Loading font images needs SDL_image; building with CONSOLE_NO_SDL_IMAGE
+ * leaves out this and console_create.
+ */
+console_t * console_create_from_font_data(SDL_Window *window, 
+        uint32_t width, uint32_t height, 
+        uint32_t row_count, uint32_t col_count,
+        uint32_t bg_color, const void *font_data, size_t font_size);
+
+/*
+ * Create a console using the 10x16 font compiled into the engine (see embedded_font.h),
+ * with no file access or image decoding.
+ */
+console_t * console_create_with_embedded_font(SDL_Window *window, 
+        uint32_t width, uint32_t height, 
+        uint32_t row_count, uint32_t col_count,
+        uint32_t bg_color);
+
 void console_destroy(console_t *console);
 
+/*
+ * Replace the console's font. The console takes ownership of the font and destroys the
+ * previous one. Glyphs are scaled to the console's cell size if they differ.
+ */
+void console_set_font(console_t *console, console_font_t *font);
+
 void console_clear(console_t *console);
 
+/*
+ * Draw the screen and present the frame. Equivalent to console_draw_screen followed
+ * by console_present.
+ */
 void console_render_screen(console_t *console, console_screen_t *screen);
 
+/*
+ * Draw the screen's cells without presenting, so more can be drawn on top
+ * (such as baked views, see baked_view.h) before console_present.
+ */
+void console_draw_screen(console_t *console, console_screen_t *screen);
+
+void console_present(console_t *console);
+
+/*
+ * Native scaling: draw the grid once at the font's own resolution into an offscreen
+ * texture, then present it with a single nearest-neighbour copy scaled by the largest
+ * integer factor that fits the window (letterboxed in the background color). Glyph
+ * copies then cost the same however large or high-DPI the window is. While enabled the
+ * console's cell size is the font's glyph size. Create baked views after enabling it.
+ * Returns false if the offscreen texture can't be created.
+ */
+bool console_set_native_scaling(console_t *console, bool enabled);
+
+
+/* Console Fonts */
+
+/*
+ * Create a font from one or more atlas pages, each a grid of glyph_width x glyph_height
+ * glyphs. Glyph codes run left to right, top to bottom through page 0, then on through
+ * page 1 and so on, so fonts can hold any number of glyphs. The surfaces are only read.
+ * Glyph source rects are worked out once here rather than for every cell drawn.
+ */
+console_font_t * console_font_create(SDL_Renderer *renderer, SDL_Surface **pages, uint32_t page_count,
+        uint32_t glyph_width, uint32_t glyph_height);
+
+#ifndef CONSOLE_NO_SDL_IMAGE
+/*
+ * Create a font from atlas image files, one per page, in glyph order.
+ */
+console_font_t * console_font_load(SDL_Renderer *renderer, const char **filenames, uint32_t page_count,
+        uint32_t glyph_width, uint32_t glyph_height);
+#endif
+
+void console_font_destroy(console_font_t *font);
+
 
 /* Console Screens */
 console_screen_t * console_screen_create(uint32_t width, uint32_t height, uint32_t bg_color);
@@ -84,10 +204,43 @@ void console_screen_destroy(console_screen_t *screen);
 
 void console_screen_clear(console_screen_t *screen);
 
-console_cell_t *console_screen_cell(const console_screen_t *screen, const uint32_t x, const uint32_t y);
+/*
+ * Lazy clearing: console_screen_clear just starts a new generation, and a row isn't
+ * actually cleared until it is next written, so clearing costs the same whatever the
+ * screen size and rows nothing draws on are never touched. Rows not written since the
+ * last clear read as cleared (glyph 0 on the screen's background) through the functions
+ * below and are drawn as cleared too. Code reading a lazy screen's cells array directly
+ * must go through console_screen_copy_rows instead, and code writing whole rows of it
+ * directly must stamp them with console_screen_touch_rows or they stay stale.
+ */
+void console_screen_set_lazy_clear(console_screen_t *screen, bool enabled);
+
+/*
+ * Returns the cell for writing or reading. With lazy clearing the cell's whole row is
+ * brought up to date, so the pointer can be used for the rest of the row.
+ */
+console_cell_t *console_screen_cell(console_screen_t *screen, const uint32_t x, const uint32_t y);
+
+/*
+ * Copy row_count rows starting at first_row into cells, with rows that are stale under
+ * lazy clearing copied as cleared. Doesn't change the screen.
+ */
+void console_screen_copy_rows(const console_screen_t *screen, uint32_t first_row, uint32_t row_count, console_cell_t *cells);
+
+/*
+ * Mark row_count rows starting at first_row as written since the last clear, without
+ * clearing them. For code that overwrites every cell of those rows through the cells array.
+ */
+void console_screen_touch_rows(console_screen_t *screen, uint32_t first_row, uint32_t row_count);
 
 void console_screen_put_text_at(console_screen_t *screen, const char *text, console_rect_t recti, uint32_t fg_color, uint32_t bg_color);
 
+/*
+ * printf-style text output. Formats into a stack buffer (no heap allocation) and then
+ * lays the text out exactly like console_screen_put_text_at.
+ */
+void console_screen_printf_at(console_screen_t *screen, console_rect_t rect, uint32_t fg_color, uint32_t bg_color, const char *format, ...);
+
 void console_screen_put_view_at(console_screen_t *screen, console_view_t *view, uint32_t x, uint32_t y);
 
 void console_screen_set_cell(console_screen_t *screen, uint32_t x, uint32_t y, console_cell_t cell);
@@ -95,12 +248,69 @@ void console_screen_set_cell(console_screen_t *screen, uint32_t x, uint32_t y, c
 void console_screen_set_cells(console_screen_t *screen, console_rect_t *rect, console_cell_t *cells);
 
 
+/* Console Text */
+
+/*
+ * Measure how the given text would be laid out by console_screen_put_text_at in a rect
+ * of the given width (and unlimited height), without touching any cells.
+ * If line_breaks is non-NULL, the text offset of the first word of each line is stored in it,
+ * up to max_breaks entries; line_count may exceed max_breaks.
+ */
+console_text_metrics_t console_text_measure(const char *text, uint32_t width, uint32_t *line_breaks, uint32_t max_breaks);
+
+
 /* Console Views */
 
 console_view_t *console_view_from_rexfile(const char *filename);
 
+/*
+ * Build a view from REXPaint data already in memory (gzip-compressed as in a .xp file, or raw).
+ */
+console_view_t *console_view_from_rexdata(const void *data, size_t size);
+
+/*
+ * Build a view of one rect of a large REXPaint map, decoding only the columns it covers
+ * (see rex_load_region). Returns NULL if the rect falls outside the map or can't be read.
+ */
+console_view_t *console_view_from_rex_region(const rex_index_t *index, console_rect_t rect);
+
 void console_view_destroy(console_view_t *view);
 
+/*
+ * Record that the view's cells were changed, so anything cached from them (baked
+ * textures) is rebuilt. Call after writing to view->cells directly.
+ */
+void console_view_touch(console_view_t *view);
+
+/*
+ * Returns false, changing nothing, if the view's cells are mapped from a view file.
+ */
+bool console_view_set_cell(console_view_t *view, uint32_t x, uint32_t y, console_cell_t cell);
+
+
+/* Layered Views */
+
+/*
+ * Load a REXPaint file keeping each of its layers, so variants (lit/unlit, damaged, ...)
+ * can be drawn by choosing which layers to composite. Layer i is selected by bit i of a mask.
+ */
+console_layered_view_t *console_layered_view_from_rexfile(const char *filename);
+
+void console_layered_view_destroy(console_layered_view_t *layered);
+
+/*
+ * The composite of the selected layers, built the first time a mask is requested and cached
+ * after that. The view belongs to the layered view; don't destroy or modify it.
+ * Compositing follows console_view_from_rexfile: the lowest-numbered opaque layer wins.
+ */
+console_view_t *console_layered_view_composite(console_layered_view_t *layered, uint32_t layer_mask);
+
+/*
+ * Composite just the given region of the selected layers into cells (rect.width * rect.height,
+ * row-major), without caching. The rect must lie within the layered view.
+ */
+void console_layered_view_composite_rect(console_layered_view_t *layered, uint32_t layer_mask, console_rect_t rect, console_cell_t *cells);
+
 
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef EMBEDDED_FONT_H
+#define EMBEDDED_FONT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*
+ * Embedded fonts - font atlases compiled into the binary as 1-bit bitmaps.
+ *
+ * The bitmap is the whole atlas image, one bit per pixel (most significant bit first),
+ * each row padded to a whole byte. Glyphs are laid out as in the atlas image: columns
+ * glyphs per row, glyph 0 at the top left. Generate the data with tools/font2c.
+ */
+
+
+typedef struct {
+    uint32_t glyph_width;       // pixels
+    uint32_t glyph_height;      // pixels
+    uint32_t columns;           // glyphs per atlas row
+    uint32_t glyph_count;
+    uint32_t atlas_width;       // pixels
+    uint32_t atlas_height;      // pixels
+    uint32_t row_bytes;         // bytes per atlas row in bits
+    const uint8_t *bits;
+} embedded_font_t;
+
+// The default 10x16 console font, generated from assets/font10x16.png
+extern const embedded_font_t console_embedded_font;
+
+
+/*
+ * Whether pixel (x, y) of the given glyph is set.
+ */
+static inline bool embedded_font_pixel(const embedded_font_t *font, uint32_t glyph, uint32_t x, uint32_t y) {
+    uint32_t atlas_x = ((glyph % font->columns) * font->glyph_width) + x;
+    uint32_t atlas_y = ((glyph / font->columns) * font->glyph_height) + y;
+    return (font->bits[(atlas_y * font->row_bytes) + (atlas_x / 8)] & (0x80 >> (atlas_x % 8))) != 0;
+}
+
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Generated by tools/font2c from assets/font10x16.png - do not edit.
+ */
+
+#include "embedded_font.h"
+
+
+static const uint8_t console_embedded_font_bits[5120] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x00, 0x00, 0x07, 0xf3, 0xf8, 0x00,
+    0x00, 0x0f, 0xc3, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x3f, 0x3f, 0x06, 0x33, 0x18, 0x00,
+    0x00, 0x10, 0x27, 0xf8, 0xee, 0x04, 0x03, 0x00, 0xc0, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x0f, 0x61, 0x86, 0x33, 0x18, 0x30,
+    0x00, 0x14, 0xa6, 0xd9, 0xff, 0x0e, 0x07, 0x81, 0xe0, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x1b, 0x61, 0x87, 0xf3, 0xf8, 0x30,
+    0x00, 0x10, 0x27, 0xf9, 0xff, 0x1f, 0x07, 0x83, 0xf0, 0x00, 0xff, 0xc7, 0x8e, 0x1c, 0x31, 0x61, 0x86, 0x03, 0x19, 0xb6,
+    0x00, 0x13, 0x27, 0x39, 0xff, 0x3f, 0x9c, 0xe7, 0xf8, 0x30, 0xf3, 0xcc, 0xcc, 0xcc, 0xfc, 0x61, 0x86, 0x03, 0x18, 0x78,
+    0x00, 0x10, 0x27, 0xf9, 0xff, 0x7f, 0xdc, 0xe7, 0xf8, 0x78, 0xe1, 0xd8, 0x69, 0xe5, 0x86, 0x3f, 0x06, 0x03, 0x19, 0xce,
+    0x00, 0x17, 0xa6, 0x18, 0xfe, 0x3f, 0x9c, 0xe3, 0xf0, 0x78, 0xe1, 0xd8, 0x69, 0xe5, 0x86, 0x0c, 0x0e, 0x03, 0x38, 0x78,
+    0x00, 0x13, 0x27, 0x38, 0x7c, 0x1f, 0x03, 0x00, 0xc0, 0x30, 0xf3, 0xcc, 0xcc, 0xcd, 0x86, 0x3f, 0x1e, 0x07, 0x39, 0xb6,
+    0x00, 0x10, 0x27, 0xf8, 0x38, 0x0e, 0x03, 0x00, 0xc0, 0x00, 0xff, 0xc7, 0x8e, 0x1d, 0x86, 0x0c, 0x1e, 0x07, 0x30, 0x30,
+    0x00, 0x0f, 0xc3, 0xf0, 0x10, 0x04, 0x07, 0x81, 0xe0, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0xfc, 0x0c, 0x1c, 0x06, 0x00, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc0, 0x0f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x00, 0x20, 0xc0, 0xc6, 0x3f, 0x8f, 0xc0, 0x00, 0x30, 0x0c, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x60, 0x00, 0x61, 0xe0, 0xc6, 0x6d, 0x98, 0x60, 0x00, 0x78, 0x1e, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0xff,
+    0x70, 0x00, 0xe3, 0xf0, 0xc6, 0x6d, 0x8c, 0x00, 0x00, 0xfc, 0x3f, 0x03, 0x00, 0x40, 0x20, 0x00, 0x00, 0x00, 0xe1, 0xff,
+    0x78, 0x01, 0xe6, 0xd8, 0xc6, 0x6d, 0x87, 0x80, 0x01, 0xb6, 0x6d, 0x83, 0x00, 0x60, 0x60, 0x00, 0x04, 0x40, 0xe0, 0xfe,
+    0x7e, 0x07, 0xe0, 0xc0, 0xc6, 0x6d, 0x8c, 0xc0, 0x00, 0x30, 0x0c, 0x03, 0x00, 0x30, 0xc0, 0x60, 0x0c, 0x61, 0xf0, 0xfe,
+    0x7f, 0x9f, 0xe0, 0xc0, 0xc6, 0x3d, 0x98, 0x60, 0x00, 0x30, 0x0c, 0x03, 0x07, 0xf9, 0xfe, 0x60, 0x1f, 0xf1, 0xf0, 0x7c,
+    0x7e, 0x07, 0xe0, 0xc0, 0xc6, 0x0d, 0x8c, 0xc0, 0x00, 0x30, 0x0c, 0x03, 0x07, 0xf9, 0xfe, 0x60, 0x1f, 0xf3, 0xf8, 0x7c,
+    0x78, 0x01, 0xe6, 0xd8, 0xc6, 0x0d, 0x87, 0x87, 0xf9, 0xb6, 0x0c, 0x1b, 0x60, 0x30, 0xc0, 0x7f, 0x8c, 0x63, 0xf8, 0x38,
+    0x70, 0x00, 0xe3, 0xf0, 0x00, 0x0d, 0x80, 0xc7, 0xf8, 0xfc, 0x0c, 0x0f, 0xc0, 0x60, 0x60, 0x00, 0x04, 0x47, 0xfc, 0x38,
+    0x60, 0x00, 0x61, 0xe0, 0xc6, 0x0d, 0x98, 0x67, 0xf8, 0x78, 0x0c, 0x07, 0x80, 0x40, 0x20, 0x00, 0x00, 0x07, 0xfc, 0x10,
+    0x40, 0x00, 0x20, 0xc0, 0xc6, 0x0d, 0x8f, 0xc7, 0xf9, 0xfe, 0x0c, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x0e, 0x01, 0xe0, 0x60, 0x06, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0xcc, 0x3f, 0x1b, 0x63, 0x30, 0x60, 0x0c, 0x03, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0x03, 0x03, 0x30, 0xcc, 0x61, 0x9b, 0x63, 0x30, 0x40, 0x18, 0x01, 0x86, 0xd8, 0x30, 0x00, 0x00, 0x00, 0x00, 0x06,
+    0x00, 0x03, 0x01, 0x21, 0xfe, 0x60, 0x8e, 0xc3, 0x30, 0x80, 0x30, 0x00, 0xc3, 0xf0, 0x30, 0x00, 0x00, 0x00, 0x00, 0x0c,
+    0x00, 0x03, 0x00, 0x00, 0xcc, 0x60, 0x01, 0x81, 0xe0, 0x00, 0x30, 0x00, 0xc1, 0xe0, 0x30, 0x00, 0x00, 0x00, 0x00, 0x18,
+    0x00, 0x03, 0x00, 0x00, 0xcc, 0x3f, 0x03, 0x03, 0xd8, 0x00, 0x30, 0x00, 0xc7, 0xf9, 0xfe, 0x00, 0x1f, 0xe0, 0x00, 0x30,
+    0x00, 0x03, 0x00, 0x00, 0xcc, 0x01, 0x86, 0x06, 0x70, 0x00, 0x30, 0x00, 0xc1, 0xe0, 0x30, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x00, 0x03, 0x00, 0x01, 0xfe, 0x41, 0x8d, 0xc6, 0x30, 0x00, 0x30, 0x00, 0xc3, 0xf0, 0x30, 0x00, 0x00, 0x00, 0x00, 0xc0,
+    0x00, 0x00, 0x00, 0x00, 0xcc, 0x61, 0x9b, 0x66, 0x30, 0x00, 0x18, 0x01, 0x86, 0xd8, 0x30, 0x00, 0x00, 0x00, 0x01, 0x80,
+    0x00, 0x03, 0x00, 0x00, 0xcc, 0x3f, 0x1b, 0x66, 0x70, 0x00, 0x0c, 0x03, 0x00, 0xc0, 0x00, 0x0c, 0x00, 0x00, 0xc1, 0x00,
+    0x00, 0x03, 0x00, 0x00, 0xcc, 0x0c, 0x01, 0xc3, 0xd8, 0x00, 0x06, 0x06, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0xc0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3f, 0x03, 0x03, 0xf0, 0xfc, 0x03, 0x1f, 0xe0, 0xf1, 0xfe, 0x3f, 0x0f, 0xc0, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0xfc,
+    0x61, 0x87, 0x06, 0x19, 0x86, 0x07, 0x18, 0x01, 0x81, 0x86, 0x61, 0x98, 0x60, 0x00, 0x00, 0x06, 0x00, 0x01, 0x81, 0x86,
+    0x61, 0x8f, 0x00, 0x18, 0x06, 0x0f, 0x18, 0x03, 0x00, 0x06, 0x61, 0x98, 0x60, 0x00, 0x00, 0x0c, 0x00, 0x00, 0xc1, 0x86,
+    0x63, 0x83, 0x00, 0x18, 0x06, 0x1b, 0x18, 0x06, 0x00, 0x0c, 0x61, 0x98, 0x60, 0x00, 0x00, 0x18, 0x0f, 0xc0, 0x60, 0x06,
+    0x67, 0x83, 0x00, 0x30, 0x06, 0x33, 0x18, 0x06, 0x00, 0x18, 0x61, 0x98, 0x60, 0xc0, 0x30, 0x30, 0x00, 0x00, 0x30, 0x1c,
+    0x6d, 0x83, 0x01, 0xe0, 0x7c, 0x63, 0x1f, 0xc7, 0xf0, 0x30, 0x3f, 0x0f, 0xe0, 0xc0, 0x30, 0x60, 0x00, 0x00, 0x18, 0x30,
+    0x79, 0x83, 0x03, 0x00, 0x06, 0x7f, 0x80, 0x66, 0x18, 0x30, 0x61, 0x80, 0x60, 0x00, 0x00, 0x30, 0x00, 0x00, 0x30, 0x30,
+    0x71, 0x83, 0x06, 0x00, 0x06, 0x03, 0x00, 0x66, 0x18, 0x30, 0x61, 0x80, 0x60, 0x00, 0x00, 0x18, 0x0f, 0xc0, 0x60, 0x30,
+    0x61, 0x83, 0x06, 0x00, 0x06, 0x03, 0x00, 0x66, 0x18, 0x30, 0x61, 0x80, 0xc0, 0x00, 0x00, 0x0c, 0x00, 0x00, 0xc0, 0x00,
+    0x61, 0x83, 0x06, 0x19, 0x86, 0x03, 0x18, 0x66, 0x18, 0x30, 0x61, 0x81, 0x80, 0xc0, 0x30, 0x06, 0x00, 0x01, 0x80, 0x30,
+    0x3f, 0x0f, 0xc7, 0xf8, 0xfc, 0x07, 0x8f, 0xc3, 0xf0, 0x30, 0x3f, 0x0f, 0x00, 0xc0, 0x30, 0x03, 0x00, 0x03, 0x00, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3f, 0x07, 0x87, 0xf0, 0xfc, 0x7f, 0x1f, 0xe7, 0xf8, 0xfc, 0x61, 0x87, 0x80, 0x79, 0xc6, 0x78, 0x18, 0x66, 0x18, 0xfc,
+    0x61, 0x8c, 0xc3, 0x19, 0x86, 0x31, 0x8c, 0x63, 0x19, 0x86, 0x61, 0x83, 0x00, 0x30, 0xc6, 0x30, 0x1c, 0xe7, 0x19, 0x86,
+    0x67, 0x98, 0x63, 0x19, 0x82, 0x31, 0x8c, 0x23, 0x09, 0x82, 0x61, 0x83, 0x00, 0x30, 0xcc, 0x30, 0x1f, 0xe7, 0x99, 0x86,
+    0x6d, 0x98, 0x63, 0x19, 0x80, 0x31, 0x8c, 0x03, 0x01, 0x80, 0x61, 0x83, 0x00, 0x30, 0xd8, 0x30, 0x1b, 0x66, 0xd9, 0x86,
+    0x6d, 0x98, 0x63, 0x19, 0x80, 0x31, 0x8c, 0x83, 0x21, 0x80, 0x61, 0x83, 0x00, 0x30, 0xf0, 0x30, 0x18, 0x66, 0x79, 0x86,
+    0x6d, 0x9f, 0xe3, 0xf1, 0x80, 0x31, 0x8f, 0x83, 0xe1, 0x80, 0x7f, 0x83, 0x00, 0x30, 0xe0, 0x30, 0x18, 0x66, 0x39, 0x86,
+    0x6d, 0x98, 0x63, 0x19, 0x80, 0x31, 0x8c, 0x83, 0x21, 0x9e, 0x61, 0x83, 0x00, 0x30, 0xf0, 0x30, 0x18, 0x66, 0x19, 0x86,
+    0x6d, 0x98, 0x63, 0x19, 0x80, 0x31, 0x8c, 0x03, 0x01, 0x86, 0x61, 0x83, 0x06, 0x30, 0xd8, 0x30, 0x18, 0x66, 0x19, 0x86,
+    0x67, 0x18, 0x63, 0x19, 0x82, 0x31, 0x8c, 0x23, 0x01, 0x86, 0x61, 0x83, 0x06, 0x30, 0xcc, 0x30, 0x98, 0x66, 0x19, 0x86,
+    0x60, 0x18, 0x63, 0x19, 0x86, 0x31, 0x8c, 0x63, 0x01, 0x8e, 0x61, 0x83, 0x06, 0x30, 0xc6, 0x31, 0x98, 0x66, 0x19, 0x86,
+    0x3f, 0x18, 0x67, 0xf0, 0xfc, 0x7f, 0x1f, 0xe7, 0x80, 0xfa, 0x61, 0x87, 0x83, 0xe1, 0xc6, 0x7f, 0x98, 0x66, 0x18, 0xfc,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+    0x7f, 0x0f, 0xc7, 0xf0, 0xfc, 0x7f, 0x98, 0x66, 0x19, 0x86, 0x61, 0x98, 0x67, 0xf8, 0x78, 0x00, 0x07, 0x80, 0xe0, 0x00,
+    0x31, 0x98, 0x63, 0x19, 0x86, 0x6d, 0x98, 0x66, 0x19, 0x86, 0x61, 0x98, 0x66, 0x18, 0x60, 0x40, 0x01, 0x81, 0xb0, 0x00,
+    0x31, 0x98, 0x63, 0x19, 0x82, 0x4c, 0x98, 0x66, 0x19, 0x86, 0x61, 0x98, 0x64, 0x18, 0x60, 0x60, 0x01, 0x83, 0x18, 0x00,
+    0x31, 0x98, 0x63, 0x19, 0x80, 0x0c, 0x18, 0x66, 0x19, 0x86, 0x33, 0x18, 0x60, 0x30, 0x60, 0x30, 0x01, 0x80, 0x00, 0x00,
+    0x31, 0x98, 0x63, 0x19, 0x80, 0x0c, 0x18, 0x66, 0x19, 0x86, 0x1e, 0x0c, 0xc0, 0x60, 0x60, 0x18, 0x01, 0x80, 0x00, 0x00,
+    0x3f, 0x18, 0x63, 0xf0, 0xfc, 0x0c, 0x18, 0x66, 0x19, 0x86, 0x0c, 0x07, 0x80, 0xc0, 0x60, 0x0c, 0x01, 0x80, 0x00, 0x00,
+    0x30, 0x18, 0x63, 0x60, 0x06, 0x0c, 0x18, 0x66, 0x19, 0xb6, 0x1e, 0x03, 0x01, 0x80, 0x60, 0x06, 0x01, 0x80, 0x00, 0x00,
+    0x30, 0x18, 0x63, 0x30, 0x06, 0x0c, 0x18, 0x66, 0x19, 0xb6, 0x33, 0x03, 0x03, 0x00, 0x60, 0x03, 0x01, 0x80, 0x00, 0x00,
+    0x30, 0x19, 0x63, 0x19, 0x06, 0x0c, 0x18, 0x63, 0x31, 0xfe, 0x61, 0x83, 0x06, 0x08, 0x60, 0x01, 0x81, 0x80, 0x00, 0x00,
+    0x30, 0x19, 0xe3, 0x19, 0x86, 0x0c, 0x18, 0x61, 0xe0, 0xcc, 0x61, 0x83, 0x06, 0x18, 0x60, 0x00, 0x81, 0x80, 0x00, 0x00,
+    0x78, 0x0f, 0xc7, 0x18, 0xfc, 0x1e, 0x0f, 0xc0, 0xc0, 0xcc, 0x61, 0x87, 0x87, 0xf8, 0x78, 0x00, 0x07, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xfe,
+    0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0c, 0x00, 0x07, 0x00, 0x00, 0x07, 0x00, 0x00, 0xe0, 0x00, 0x70, 0x00, 0x00, 0x01, 0xc0, 0x1c, 0x00, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x01, 0xb0, 0x00, 0x30, 0x00, 0x00, 0x00, 0xc0, 0x0c, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x01, 0x90, 0x00, 0x30, 0x03, 0x00, 0x30, 0xc0, 0x0c, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0x30, 0x03, 0x00, 0x30, 0xc0, 0x0c, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0x30, 0x00, 0x00, 0x00, 0xc0, 0x0c, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x0f, 0x83, 0xe0, 0x7c, 0x1f, 0x07, 0xc3, 0xe0, 0xf6, 0x3e, 0x07, 0x00, 0x70, 0xcc, 0x0c, 0x36, 0xc6, 0xf0, 0x7c,
+    0x00, 0x00, 0xc3, 0x30, 0xc6, 0x33, 0x0c, 0x61, 0x81, 0x8c, 0x33, 0x03, 0x00, 0x30, 0xd8, 0x0c, 0x1f, 0xe3, 0x18, 0xc6,
+    0x00, 0x0f, 0xc3, 0x18, 0xc0, 0x63, 0x0f, 0xe1, 0x81, 0x8c, 0x31, 0x83, 0x00, 0x30, 0xf0, 0x0c, 0x1b, 0x63, 0x18, 0xc6,
+    0x00, 0x18, 0xc3, 0x18, 0xc0, 0x63, 0x0c, 0x01, 0x81, 0x8c, 0x31, 0x83, 0x00, 0x30, 0xd8, 0x0c, 0x1b, 0x63, 0x18, 0xc6,
+    0x00, 0x18, 0xc3, 0x18, 0xc6, 0x63, 0x0c, 0x61, 0x80, 0xfc, 0x31, 0x83, 0x00, 0x30, 0xcc, 0x0c, 0x1b, 0x63, 0x18, 0xc6,
+    0x00, 0x0f, 0x66, 0xf0, 0x7c, 0x3d, 0x87, 0xc3, 0xc0, 0x0c, 0x71, 0x87, 0x86, 0x31, 0xc6, 0x1e, 0x1b, 0x63, 0x18, 0x7c,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x8c, 0x00, 0x00, 0x06, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x00, 0x00, 0x03, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x0e, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x0c, 0x03, 0x03, 0xd8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x0c, 0x03, 0x06, 0xf0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x0c, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x0c, 0x03, 0x00, 0x00, 0x00,
+    0x6f, 0x0f, 0x66, 0xf0, 0x7c, 0x3f, 0x18, 0xc6, 0x19, 0x86, 0x31, 0x8c, 0x63, 0xf8, 0xe0, 0x00, 0x01, 0xc0, 0x00, 0x30,
+    0x31, 0x98, 0xc3, 0x98, 0xc6, 0x0c, 0x18, 0xc6, 0x19, 0x86, 0x1b, 0x0c, 0x63, 0x30, 0x30, 0x0c, 0x03, 0x00, 0x00, 0x78,
+    0x31, 0x98, 0xc3, 0x00, 0x70, 0x0c, 0x18, 0xc6, 0x19, 0xb6, 0x0e, 0x0c, 0x60, 0x60, 0x30, 0x0c, 0x03, 0x00, 0x00, 0xcc,
+    0x31, 0x98, 0xc3, 0x00, 0x1c, 0x0c, 0x18, 0xc3, 0x31, 0xb6, 0x0e, 0x0c, 0x60, 0xc0, 0x30, 0x0c, 0x03, 0x00, 0x01, 0x86,
+    0x3f, 0x0f, 0xc3, 0x00, 0xc6, 0x0d, 0x98, 0xc1, 0xe1, 0xfe, 0x1b, 0x07, 0xe1, 0x98, 0x30, 0x0c, 0x03, 0x00, 0x01, 0x86,
+    0x30, 0x00, 0xc7, 0x80, 0x7c, 0x07, 0x0f, 0x60, 0xc0, 0xcc, 0x31, 0x80, 0x63, 0xf8, 0x1c, 0x00, 0x0e, 0x00, 0x01, 0xfe,
+    0x30, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x78, 0x01, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78,
+    0x3f, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x06, 0x18, 0xcc,
+    0x61, 0x80, 0x00, 0x30, 0x70, 0x00, 0x06, 0x01, 0xe0, 0x00, 0x0e, 0x00, 0x01, 0x80, 0x00, 0x1c, 0x06, 0x06, 0x18, 0x78,
+    0x60, 0x98, 0xc0, 0x60, 0xd8, 0x63, 0x03, 0x03, 0x30, 0x00, 0x1b, 0x0c, 0x60, 0xc1, 0x8c, 0x36, 0x03, 0x00, 0x00, 0x00,
+    0x60, 0x18, 0xc0, 0xc1, 0x8c, 0x63, 0x01, 0x81, 0xe0, 0x00, 0x31, 0x8c, 0x60, 0x61, 0x8c, 0x63, 0x01, 0x81, 0xe0, 0x78,
+    0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x30, 0xcc,
+    0x60, 0x18, 0xc1, 0xf0, 0xf8, 0x3e, 0x0f, 0x83, 0xe0, 0x7c, 0x1f, 0x07, 0xc1, 0xf0, 0x70, 0x1c, 0x07, 0x06, 0x19, 0x86,
+    0x60, 0x18, 0xc3, 0x18, 0x0c, 0x03, 0x00, 0xc0, 0x30, 0xc6, 0x31, 0x8c, 0x63, 0x18, 0x30, 0x0c, 0x03, 0x06, 0x19, 0x86,
+    0x60, 0x98, 0xc3, 0xf8, 0xfc, 0x3f, 0x0f, 0xc3, 0xf0, 0xc0, 0x3f, 0x8f, 0xe3, 0xf8, 0x30, 0x0c, 0x03, 0x07, 0xf9, 0xfe,
+    0x61, 0x98, 0xc3, 0x01, 0x8c, 0x63, 0x18, 0xc6, 0x30, 0xc6, 0x30, 0x0c, 0x03, 0x00, 0x30, 0x0c, 0x03, 0x06, 0x19, 0x86,
+    0x3f, 0x18, 0xc3, 0x19, 0x8c, 0x63, 0x18, 0xc6, 0x30, 0x7c, 0x31, 0x8c, 0x63, 0x18, 0x30, 0x0c, 0x03, 0x06, 0x19, 0x86,
+    0x06, 0x0f, 0x61, 0xf0, 0xf6, 0x3d, 0x8f, 0x63, 0xd8, 0x18, 0x1f, 0x07, 0xc1, 0xf0, 0x78, 0x1e, 0x07, 0x86, 0x19, 0x86,
+    0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0c, 0x00, 0x01, 0xf8, 0x10, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x18, 0x66, 0x18, 0x30, 0x0e, 0x00, 0x07, 0xe0, 0x1c,
+    0x18, 0x00, 0x03, 0x60, 0x38, 0x00, 0x06, 0x01, 0xc0, 0x60, 0x00, 0x18, 0x66, 0x18, 0x30, 0x1b, 0x00, 0x03, 0x30, 0x36,
+    0x00, 0x00, 0x06, 0x60, 0x6c, 0x31, 0x83, 0x03, 0x60, 0x30, 0x31, 0x80, 0x00, 0x00, 0xfc, 0x19, 0x18, 0x63, 0x30, 0x30,
+    0x7f, 0x80, 0x06, 0x60, 0xc6, 0x31, 0x81, 0x86, 0x30, 0x18, 0x31, 0x8f, 0xc6, 0x19, 0x86, 0x18, 0x0c, 0xc3, 0x30, 0x30,
+    0x31, 0x9d, 0xc6, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x66, 0x19, 0x80, 0x3c, 0x07, 0x83, 0xe0, 0x30,
+    0x30, 0x07, 0x67, 0xf8, 0x7c, 0x1f, 0x07, 0xc6, 0x31, 0x8c, 0x31, 0x98, 0x66, 0x19, 0x80, 0x18, 0x03, 0x03, 0x10, 0xfc,
+    0x3e, 0x03, 0x66, 0x60, 0xc6, 0x31, 0x8c, 0x66, 0x31, 0x8c, 0x31, 0x98, 0x66, 0x19, 0x80, 0x18, 0x1f, 0xe3, 0x30, 0x30,
+    0x30, 0x0f, 0xc6, 0x60, 0xc6, 0x31, 0x8c, 0x66, 0x31, 0x8c, 0x31, 0x98, 0x66, 0x19, 0x86, 0x18, 0x03, 0x03, 0x78, 0x30,
+    0x30, 0x1b, 0x06, 0x60, 0xc6, 0x31, 0x8c, 0x66, 0x31, 0x8c, 0x31, 0x98, 0x66, 0x18, 0xfc, 0x79, 0x9f, 0xe3, 0x30, 0x30,
+    0x31, 0x9b, 0x86, 0x60, 0xc6, 0x31, 0x8c, 0x66, 0x31, 0x8c, 0x1f, 0x98, 0x66, 0x18, 0x30, 0xdd, 0x83, 0x03, 0x30, 0x30,
+    0x7f, 0x8e, 0xe6, 0x78, 0x7c, 0x1f, 0x07, 0xc3, 0xd8, 0xf6, 0x01, 0x8f, 0xc3, 0xf0, 0x30, 0x77, 0x03, 0x07, 0x99, 0xb0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x63, 0xc0, 0xf0, 0x0c, 0x00, 0x00, 0x00, 0xc0, 0x30, 0x03, 0x00, 0x00, 0x00,
+    0x06, 0x01, 0x80, 0x30, 0x18, 0x00, 0x1b, 0xc0, 0x61, 0x98, 0x0c, 0x00, 0x00, 0x01, 0xc0, 0x70, 0x03, 0x00, 0x00, 0x00,
+    0x0c, 0x03, 0x00, 0x60, 0x30, 0x3d, 0x80, 0x03, 0xe1, 0x98, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x31, 0x80, 0x00, 0x00, 0x00,
+    0x18, 0x06, 0x00, 0xc0, 0x60, 0x6f, 0x18, 0x66, 0x61, 0x98, 0x0c, 0x00, 0x00, 0x00, 0xcc, 0x33, 0x03, 0x01, 0x99, 0x98,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x63, 0xb0, 0xf0, 0x0c, 0x00, 0x00, 0x00, 0xd8, 0x36, 0x03, 0x03, 0x30, 0xcc,
+    0x3e, 0x07, 0x01, 0xf1, 0x8c, 0x6f, 0x1e, 0x60, 0x00, 0x00, 0x0c, 0x1f, 0xe7, 0xf8, 0x30, 0x0c, 0x03, 0x06, 0x60, 0x66,
+    0x03, 0x03, 0x03, 0x19, 0x8c, 0x31, 0x9b, 0x67, 0xf1, 0xf8, 0x38, 0x18, 0x00, 0x18, 0x60, 0x19, 0x83, 0x03, 0x30, 0xcc,
+    0x3f, 0x03, 0x03, 0x19, 0x8c, 0x31, 0x99, 0xe0, 0x00, 0x00, 0x60, 0x18, 0x00, 0x18, 0xdc, 0x33, 0x83, 0x01, 0x99, 0x98,
+    0x63, 0x03, 0x03, 0x19, 0x8c, 0x31, 0x98, 0xe0, 0x00, 0x00, 0x61, 0x98, 0x00, 0x19, 0x86, 0x67, 0x83, 0x00, 0x00, 0x00,
+    0x63, 0x03, 0x03, 0x19, 0x8c, 0x31, 0x98, 0x60, 0x00, 0x00, 0x61, 0x80, 0x00, 0x00, 0x0c, 0x0f, 0x83, 0x00, 0x00, 0x00,
+    0x3d, 0x87, 0x81, 0xf0, 0xf6, 0x31, 0x98, 0x60, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x18, 0x01, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x01, 0x80, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xc6, 0x2a, 0xac, 0x60, 0x30, 0x0c, 0x03, 0x03, 0x30, 0x00, 0x00, 0x0c, 0xc3, 0x30, 0x00, 0x33, 0x0c, 0xc0, 0xc0, 0x00,
+    0xc6, 0x15, 0x53, 0x9c, 0x30, 0x0c, 0x03, 0x03, 0x30, 0x00, 0x00, 0x0c, 0xc3, 0x30, 0x00, 0x33, 0x0c, 0xc0, 0xc0, 0x00,
+    0x39, 0xea, 0xac, 0x60, 0x30, 0x0c, 0x03, 0x03, 0x30, 0x00, 0x00, 0x0c, 0xc3, 0x30, 0x00, 0x33, 0x0c, 0xc0, 0xc0, 0x00,
+    0x39, 0xd5, 0x53, 0x9c, 0x30, 0x0c, 0x03, 0x03, 0x30, 0x00, 0x00, 0x0c, 0xc3, 0x30, 0x00, 0x33, 0x0c, 0xc0, 0xc0, 0x00,
+    0xc6, 0x2a, 0xac, 0x60, 0x30, 0x0c, 0x03, 0x03, 0x30, 0x00, 0x00, 0x0c, 0xc3, 0x30, 0x00, 0x33, 0x0c, 0xc0, 0xc0, 0x00,
+    0xc6, 0x15, 0x53, 0x9c, 0x30, 0x0c, 0x03, 0x03, 0x30, 0x00, 0x00, 0x0c, 0xc3, 0x30, 0x00, 0x33, 0x0c, 0xc0, 0xc0, 0x00,
+    0x39, 0xea, 0xac, 0x60, 0x30, 0x0c, 0x3f, 0x03, 0x30, 0x00, 0xfc, 0x3c, 0xc3, 0x33, 0xfc, 0xf3, 0x0c, 0xcf, 0xc0, 0x00,
+    0x39, 0xd5, 0x53, 0x9c, 0x30, 0xfc, 0x03, 0x0f, 0x33, 0xfc, 0x0c, 0x00, 0xc3, 0x30, 0x0c, 0x03, 0x3f, 0xc0, 0xc3, 0xf0,
+    0xc6, 0x2a, 0xac, 0x60, 0x30, 0xfc, 0x03, 0x0f, 0x33, 0xfc, 0x0c, 0x00, 0xc3, 0x30, 0x0c, 0x03, 0x3f, 0xc0, 0xc3, 0xf0,
+    0xc6, 0x15, 0x53, 0x9c, 0x30, 0x0c, 0x3f, 0x03, 0x30, 0xcc, 0xfc, 0x3c, 0xc3, 0x33, 0xcc, 0xff, 0x00, 0x0f, 0xc0, 0x30,
+    0x39, 0xea, 0xac, 0x60, 0x30, 0x0c, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x0c, 0xc3, 0x30, 0xcc, 0x00, 0x00, 0x00, 0x00, 0x30,
+    0x39, 0xd5, 0x53, 0x9c, 0x30, 0x0c, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x0c, 0xc3, 0x30, 0xcc, 0x00, 0x00, 0x00, 0x00, 0x30,
+    0xc6, 0x2a, 0xac, 0x60, 0x30, 0x0c, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x0c, 0xc3, 0x30, 0xcc, 0x00, 0x00, 0x00, 0x00, 0x30,
+    0xc6, 0x15, 0x53, 0x9c, 0x30, 0x0c, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x0c, 0xc3, 0x30, 0xcc, 0x00, 0x00, 0x00, 0x00, 0x30,
+    0x39, 0xea, 0xac, 0x60, 0x30, 0x0c, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x0c, 0xc3, 0x30, 0xcc, 0x00, 0x00, 0x00, 0x00, 0x30,
+    0x39, 0xd5, 0x53, 0x9c, 0x30, 0x0c, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x0c, 0xc3, 0x30, 0xcc, 0x00, 0x00, 0x00, 0x00, 0x30,
+    0x0c, 0x03, 0x00, 0x00, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00, 0x33, 0x00, 0x03, 0x30, 0x30,
+    0x0c, 0x03, 0x00, 0x00, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00, 0x33, 0x00, 0x03, 0x30, 0x30,
+    0x0c, 0x03, 0x00, 0x00, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00, 0x33, 0x00, 0x03, 0x30, 0x30,
+    0x0c, 0x03, 0x00, 0x00, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00, 0x33, 0x00, 0x03, 0x30, 0x30,
+    0x0c, 0x03, 0x00, 0x00, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00, 0x33, 0x00, 0x03, 0x30, 0x30,
+    0x0c, 0x03, 0x00, 0x00, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00, 0x33, 0x00, 0x03, 0x30, 0x30,
+    0x0c, 0x03, 0x00, 0x00, 0x30, 0x00, 0x03, 0x00, 0xfc, 0xcc, 0x33, 0xcf, 0xff, 0x3f, 0xff, 0x33, 0xff, 0xff, 0x3f, 0xff,
+    0x0f, 0xff, 0xff, 0xfc, 0x3f, 0xff, 0xff, 0xf0, 0xc0, 0xcf, 0x30, 0x0c, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00,
+    0x0f, 0xff, 0xff, 0xfc, 0x3f, 0xff, 0xff, 0xf0, 0xc0, 0xcf, 0x30, 0x0c, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xc0, 0x30, 0x00, 0x03, 0x00, 0xfc, 0xcc, 0x3f, 0xcc, 0xff, 0xff, 0xcf, 0x33, 0xff, 0xff, 0x3f, 0xff,
+    0x00, 0x00, 0x00, 0xc0, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x00, 0x0c, 0xc0, 0x00, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0xc0, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x00, 0x0c, 0xc0, 0x00, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0xc0, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x00, 0x0c, 0xc0, 0x00, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0xc0, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x00, 0x0c, 0xc0, 0x00, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0xc0, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x00, 0x0c, 0xc0, 0x00, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0xc0, 0x30, 0x00, 0x03, 0x00, 0xc0, 0xcc, 0x00, 0x0c, 0xc0, 0x00, 0xcc, 0x33, 0x00, 0x03, 0x30, 0x00,
+    0x33, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x03, 0x00, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0x33, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x03, 0x00, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0x33, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x03, 0x00, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0x33, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x03, 0x00, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0x33, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x03, 0x00, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0x33, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x00, 0x00, 0x00, 0xcc, 0x0c, 0x03, 0x00, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0x33, 0x3f, 0xf0, 0x00, 0xcc, 0x0f, 0xc3, 0xf0, 0x00, 0xcc, 0xff, 0xc3, 0x00, 0x03, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0xff, 0xc0, 0x0f, 0xfc, 0xff, 0x0c, 0x03, 0x03, 0xff, 0xff, 0x0c, 0x3f, 0x00, 0xff, 0xff, 0x00, 0x3e, 0x00, 0x7f, 0xff,
+    0xff, 0xc0, 0x0f, 0xfc, 0xff, 0x0c, 0x03, 0x03, 0xff, 0xff, 0x0c, 0x3f, 0x00, 0xff, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x3f, 0xf3, 0x30, 0x00, 0x0f, 0xc3, 0xf3, 0x30, 0xcc, 0xff, 0xc0, 0x00, 0xc3, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0x00, 0x00, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x00, 0x00, 0xc3, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0x00, 0x00, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x00, 0x00, 0xc3, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0x00, 0x00, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x00, 0x00, 0xc3, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0x00, 0x00, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x00, 0x00, 0xc3, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0x00, 0x00, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x00, 0x00, 0xc3, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x03, 0x03, 0x30, 0x00, 0x00, 0x03, 0x03, 0x30, 0xcc, 0x0c, 0x00, 0x00, 0xc3, 0xff, 0xff, 0xfe, 0x00, 0x7c, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x07, 0xf8, 0x00, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x06, 0x18, 0x00, 0x61, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x06, 0x18, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x03, 0x81, 0xe0, 0x7c, 0x00, 0x03, 0x01, 0xe0, 0x78,
+    0x00, 0x07, 0xc6, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x06, 0xc3, 0x30, 0xc0, 0x00, 0x03, 0x03, 0x00, 0xcc,
+    0x00, 0x0c, 0x66, 0x00, 0xfe, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x0c, 0x66, 0x18, 0x60, 0x3b, 0x8f, 0xc6, 0x01, 0x86,
+    0x3d, 0x8c, 0x66, 0x01, 0xcc, 0x06, 0x0f, 0xe3, 0x18, 0xf6, 0x33, 0x0c, 0x66, 0x18, 0x30, 0x6e, 0xdb, 0x66, 0x01, 0x86,
+    0x67, 0x0f, 0xc6, 0x00, 0xcc, 0x0c, 0x19, 0x83, 0x19, 0xbc, 0x33, 0x1f, 0xf6, 0x18, 0xf8, 0x6e, 0xdb, 0x67, 0xe1, 0x86,
+    0x66, 0x0c, 0x66, 0x00, 0xcc, 0x18, 0x19, 0x83, 0x18, 0x30, 0x33, 0x0c, 0x63, 0x31, 0x8c, 0x6e, 0xdb, 0x66, 0x01, 0x86,
+    0x66, 0x0c, 0x66, 0x00, 0xcc, 0x30, 0x19, 0x83, 0x18, 0x30, 0x1e, 0x0c, 0x63, 0x31, 0x8c, 0x3b, 0x8f, 0xc6, 0x01, 0x86,
+    0x67, 0x0f, 0xc6, 0x00, 0xcc, 0x61, 0x99, 0x83, 0xf0, 0x30, 0x0c, 0x06, 0xc3, 0x31, 0x8c, 0x00, 0x03, 0x03, 0x01, 0x86,
+    0x3d, 0x8c, 0x06, 0x00, 0xcc, 0x7f, 0x8f, 0x03, 0x00, 0x30, 0x3f, 0x03, 0x87, 0x38, 0xf8, 0x00, 0x03, 0x01, 0xe1, 0x86,
+    0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x1f, 0xdc, 0x0e, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x03, 0x00, 0xc0, 0x00, 0x66, 0x00, 0x00, 0x00, 0x18, 0x66, 0x1b, 0x00, 0x00, 0x00,
+    0x7f, 0x83, 0x03, 0x00, 0x18, 0x0d, 0x83, 0x00, 0xc0, 0x00, 0x66, 0x00, 0x00, 0x00, 0x18, 0x66, 0x06, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0x01, 0x80, 0x30, 0x0d, 0x83, 0x00, 0x00, 0xf6, 0x3c, 0x00, 0x00, 0x00, 0x18, 0x66, 0x0c, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0x00, 0xc0, 0x60, 0x0c, 0x03, 0x00, 0x01, 0xbc, 0x00, 0x00, 0x00, 0x00, 0x18, 0x66, 0x19, 0x03, 0xf0, 0x00,
+    0x7f, 0x9f, 0xe0, 0x60, 0xc0, 0x0c, 0x03, 0x07, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x66, 0x1f, 0x03, 0xf0, 0x00,
+    0x00, 0x03, 0x00, 0xc0, 0x60, 0x0c, 0x03, 0x00, 0x00, 0xf6, 0x00, 0x03, 0x00, 0xc0, 0x18, 0x00, 0x00, 0x03, 0xf0, 0x00,
+    0x00, 0x03, 0x01, 0x80, 0x30, 0x0c, 0x03, 0x00, 0x01, 0xbc, 0x00, 0x03, 0x00, 0x00, 0x18, 0x00, 0x00, 0x03, 0xf0, 0x00,
+    0x7f, 0x83, 0x03, 0x00, 0x18, 0x0c, 0x03, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x01, 0xd8, 0x00, 0x00, 0x03, 0xf0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x03, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd8, 0x00, 0x00, 0x03, 0xf0, 0x00,
+    0x00, 0x1f, 0xe7, 0xf1, 0xfc, 0x0c, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const embedded_font_t console_embedded_font = {
+    .glyph_width = 10,
+    .glyph_height = 16,
+    .columns = 16,
+    .glyph_count = 256,
+    .atlas_width = 160,
+    .atlas_height = 256,
+    .row_bytes = 20,
+    .bits = console_embedded_font_bits,
+};
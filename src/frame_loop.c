@@ -0,0 +1,207 @@
+
+
+#include "frame_loop.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Longest an idle loop blocks with nothing scheduled; only bounds the wait, nothing is drawn
+#define FRAME_LOOP_MAX_IDLE_WAIT_MS     1000
+
+
+// Internal Functions --
+
+static bool frame_loop_wait_event(frame_loop_t *loop, SDL_Event *event, uint32_t timeout_ms);
+static bool frame_loop_screen_unchanged(frame_loop_t *loop, const console_screen_t *screen);
+static void frame_loop_fit_screen(console_screen_t **screen, const console_screen_t *like);
+
+
+// External Interface --
+
+frame_loop_t * frame_loop_create(console_t *console, uint32_t width, uint32_t height, uint32_t fps) {
+    frame_loop_t *loop = calloc(1, sizeof(frame_loop_t));
+    loop->console = console;
+    loop->presented = console_screen_create(width, height, 0);
+    loop->incoming = console_screen_create(width, height, 0);
+    loop->frame_ms = (fps > 0) ? 1000 / fps : 0;
+    loop->frame_deadline = SDL_GetTicks();
+    loop->invalidated = true;
+
+    return loop;
+}
+
+void frame_loop_destroy(frame_loop_t *loop) {
+    console_screen_destroy(loop->incoming);
+    console_screen_destroy(loop->presented);
+    free(loop);
+}
+
+bool frame_loop_next_event(frame_loop_t *loop, SDL_Event *event) {
+    // Anything already queued is handled this frame, however much there is
+    if (SDL_PollEvent(event)) {
+        if (loop->idle) {
+            loop->woken = true;
+        }
+        if (event->type == SDL_WINDOWEVENT) {
+            loop->invalidated = true;
+        }
+        return true;
+    }
+    if (loop->woken || loop->invalidated) {
+        return false;
+    }
+
+    uint32_t now = SDL_GetTicks();
+    if (loop->idle) {
+        // Sleep until input arrives or the next scheduled wakeup
+        uint32_t timeout = FRAME_LOOP_MAX_IDLE_WAIT_MS;
+        if (loop->has_wakeup) {
+            timeout = SDL_TICKS_PASSED(now, loop->wakeup) ? 0 : loop->wakeup - now;
+        }
+        return frame_loop_wait_event(loop, event, timeout);
+    }
+
+    // Active: keep handling input as it comes until the frame is due
+    if (SDL_TICKS_PASSED(now, loop->frame_deadline)) {
+        return false;
+    }
+    return frame_loop_wait_event(loop, event, loop->frame_deadline - now);
+}
+
+void frame_loop_schedule(frame_loop_t *loop, uint32_t delay_ms) {
+    uint32_t wakeup = SDL_GetTicks() + delay_ms;
+    if (!loop->has_wakeup || SDL_TICKS_PASSED(loop->wakeup, wakeup)) {
+        loop->wakeup = wakeup;
+        loop->has_wakeup = true;
+    }
+}
+
+void frame_loop_invalidate(frame_loop_t *loop) {
+    loop->invalidated = true;
+}
+
+bool frame_loop_present(frame_loop_t *loop, console_screen_t *screen) {
+    uint32_t now = SDL_GetTicks();
+    loop->woken = false;
+    loop->frame_deadline = now + loop->frame_ms;
+    if (loop->has_wakeup && SDL_TICKS_PASSED(now, loop->wakeup)) {
+        loop->has_wakeup = false;
+    }
+
+    bool unchanged = frame_loop_screen_unchanged(loop, screen);
+    if (unchanged && !loop->invalidated) {
+        loop->idle = true;
+        loop->frames_skipped += 1;
+        return false;
+    }
+
+    console_clear(loop->console);
+    console_render_screen(loop->console, screen);
+
+    console_screen_t *swap = loop->presented;
+    loop->presented = loop->incoming;
+    loop->incoming = swap;
+
+    loop->idle = false;
+    loop->invalidated = false;
+    loop->frames_presented += 1;
+    return true;
+}
+
+
+// Internal Functions --
+
+static
+bool frame_loop_wait_event(frame_loop_t *loop, SDL_Event *event, uint32_t timeout_ms) {
+    if (timeout_ms == 0 || !SDL_WaitEventTimeout(event, (int)timeout_ms)) {
+        return false;
+    }
+
+    if (loop->idle) {
+        loop->woken = true;
+    }
+    if (event->type == SDL_WINDOWEVENT) {
+        loop->invalidated = true;
+    }
+    return true;
+}
+
+/*
+ * Take a copy of the screen as it will look (lazily cleared rows come out cleared) and
+ * compare it with the last one presented.
+ */
+static
+bool frame_loop_screen_unchanged(frame_loop_t *loop, const console_screen_t *screen) {
+    frame_loop_fit_screen(&loop->incoming, screen);
+    loop->incoming->bg_color = screen->bg_color;
+    console_screen_copy_rows(screen, 0, screen->height, loop->incoming->cells);
+
+    const console_screen_t *presented = loop->presented;
+    if (presented->width != screen->width || presented->height != screen->height ||
+            presented->bg_color != screen->bg_color) {
+        return false;
+    }
+    return memcmp(presented->cells, loop->incoming->cells, (size_t)screen->width * screen->height * sizeof(console_cell_t)) == 0;
+}
+
+static
+void frame_loop_fit_screen(console_screen_t **screen, const console_screen_t *like) {
+    if ((*screen)->width != like->width || (*screen)->height != like->height) {
+        console_screen_destroy(*screen);
+        *screen = console_screen_create(like->width, like->height, 0);
+    }
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <time.h>
+
+int main() {
+    SDL_Init(SDL_INIT_VIDEO);
+    SDL_Window *window = SDL_CreateWindow("frame_loop test", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+            1280, 768, SDL_WINDOW_HIDDEN);
+    console_t *console = console_create_with_embedded_font(window, 1280, 768, 48, 128, 255);
+    console_screen_t *screen = console_screen_create(128, 48, 255);
+    frame_loop_t *loop = frame_loop_create(console, 128, 48, 30);
+
+    // One second of a static screen, with a wakeup every 250 ms standing in for a slow animation
+    SDL_Event event;
+    clock_t cpu_start = clock();
+    uint32_t start = SDL_GetTicks();
+    uint32_t frames = 0;
+    while (SDL_GetTicks() - start < 1000) {
+        while (frame_loop_next_event(loop, &event)) {}
+        console_screen_put_text_at(screen, "Nothing to see here", (console_rect_t){10, 10, 20, 1}, 0xffffffff, 255);
+        if (!loop->has_wakeup) {
+            frame_loop_schedule(loop, 250);
+        }
+        frame_loop_present(loop, screen);
+        frames += 1;
+    }
+    double cpu_ms = (double)(clock() - cpu_start) * 1000.0 / CLOCKS_PER_SEC;
+
+    printf("Static screen for 1s: %u loop passes, %u presented, %u skipped, %.1f ms CPU\n",
+            frames, loop->frames_presented, loop->frames_skipped, cpu_ms);
+    bool idled = loop->frames_presented == 1 && frames <= 8;
+
+    // A change is presented on the next pass
+    console_screen_put_text_at(screen, "Something changed", (console_rect_t){10, 12, 20, 1}, 0xffffffff, 255);
+    bool presented = frame_loop_present(loop, screen);
+    printf("Changed screen presented: %s\n", presented ? "yes" : "NO");
+
+    frame_loop_destroy(loop);
+    console_screen_destroy(screen);
+    console_destroy(console);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return (idled && presented) ? 0 : 1;
+}
+
+#endif
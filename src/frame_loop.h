@@ -0,0 +1,84 @@
+#ifndef FRAME_LOOP_H
+#define FRAME_LOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+#include "console.h"
+
+
+/*
+ * Frame loop - frame pacing that goes idle while nothing on screen changes.
+ *
+ * The loop keeps a copy of the last screen it presented. A frame whose screen matches it
+ * is not drawn at all, and until something happens the loop then blocks in
+ * SDL_WaitEventTimeout instead of waking every frame, so a static screen costs close to
+ * no CPU. Input wakes it straight away; animations and other timed changes ask for a
+ * wakeup with frame_loop_schedule. While the screen is changing the loop paces frames to
+ * the given rate, handling input as it arrives rather than once per frame.
+ *
+ *  Example usage:
+ *      frame_loop_t *loop = frame_loop_create(console, NUM_COLS, NUM_ROWS, 30);
+ *      while (running) {
+ *          while (frame_loop_next_event(loop, &event)) {
+ *              ...handle event...
+ *          }
+ *          ...compose screen...
+ *          if (animating) { frame_loop_schedule(loop, frame_ms); }
+ *          frame_loop_present(loop, screen);
+ *      }
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    console_t *console;
+    console_screen_t *presented;    // copy of the last screen presented
+    console_screen_t *incoming;     // copy of the screen being presented, swapped in once it is
+    uint32_t frame_ms;
+    uint32_t frame_deadline;        // ticks at which the next frame is due while active
+    uint32_t wakeup;                // ticks of the earliest scheduled wakeup, if has_wakeup
+    bool has_wakeup;
+    bool idle;                      // the last frame matched the presented screen
+    bool woken;                     // input arrived during an idle wait
+    bool invalidated;               // present the next frame even if it's unchanged
+    uint32_t frames_presented;
+    uint32_t frames_skipped;
+} frame_loop_t;
+// Should only use the loop via functions, not direct property access
+
+
+/** Public Interface **/
+
+frame_loop_t * frame_loop_create(console_t *console, uint32_t width, uint32_t height, uint32_t fps);
+
+void frame_loop_destroy(frame_loop_t *loop);
+
+/**
+ *  Fetch the next event for this frame. Returns false when it is time to compose the next
+ *  frame: at once if events woke an idle loop, at the frame deadline while active, and
+ *  otherwise when a scheduled wakeup falls due. Window events invalidate the loop.
+ */
+bool frame_loop_next_event(frame_loop_t *loop, SDL_Event *event);
+
+/**
+ *  Ask for a frame within delay_ms even if no input arrives, e.g. for the next animation frame.
+ */
+void frame_loop_schedule(frame_loop_t *loop, uint32_t delay_ms);
+
+/**
+ *  Make the next frame present even if its screen is unchanged (after the window is
+ *  exposed, the font is changed and so on).
+ */
+void frame_loop_invalidate(frame_loop_t *loop);
+
+/**
+ *  Clear the console, draw the screen and present it, unless it matches the last screen
+ *  presented. Returns true if the frame was presented.
+ */
+bool frame_loop_present(frame_loop_t *loop, console_screen_t *screen);
+
+
+#endif
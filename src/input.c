@@ -0,0 +1,159 @@
+
+
+#include "input.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Internal Functions --
+
+static void input_update_keys(input_t *input, const SDL_Event *event);
+
+
+// External Interface --
+
+input_t * input_create(void) {
+    return calloc(1, sizeof(input_t));
+}
+
+void input_destroy(input_t *input) {
+    free(input);
+}
+
+bool input_record(input_t *input, const SDL_Event *event) {
+    uint64_t now = SDL_GetPerformanceCounter();
+    if (input->frame_first_event == 0) {
+        input->frame_first_event = now;
+    }
+    input_update_keys(input, event);
+
+    if (input->count == INPUT_RING_SIZE) {
+        input->dropped += 1;
+        return false;
+    }
+
+    input_event_t *slot = &input->events[(input->head + input->count) & (INPUT_RING_SIZE - 1)];
+    slot->event = *event;
+    slot->timestamp = now;
+    input->count += 1;
+    return true;
+}
+
+uint32_t input_pump(input_t *input) {
+    uint32_t recorded = 0;
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        input_record(input, &event);
+        recorded += 1;
+    }
+
+    return recorded;
+}
+
+input_event_t * input_next(input_t *input) {
+    if (input->count == 0) {
+        return NULL;
+    }
+
+    input_event_t *event = &input->events[input->head];
+    input->head = (input->head + 1) & (INPUT_RING_SIZE - 1);
+    input->count -= 1;
+    return event;
+}
+
+bool input_key_down(const input_t *input, SDL_Scancode scancode) {
+    if ((uint32_t)scancode >= SDL_NUM_SCANCODES) {
+        return false;
+    }
+    return (input->keys_down[scancode / 64] >> (scancode % 64)) & 1;
+}
+
+void input_end_frame(input_t *input, bool presented) {
+    if (presented && input->frame_first_event != 0) {
+        double ms = (double)(SDL_GetPerformanceCounter() - input->frame_first_event) * 1000.0 /
+                (double)SDL_GetPerformanceFrequency();
+
+        input_latency_t *latency = &input->latency;
+        latency->last_ms = ms;
+        latency->samples += 1;
+        input->latency_total_ms += ms;
+        latency->average_ms = input->latency_total_ms / latency->samples;
+        if (ms > latency->max_ms) {
+            latency->max_ms = ms;
+        }
+    }
+    input->frame_first_event = 0;
+}
+
+input_latency_t input_latency(const input_t *input) {
+    return input->latency;
+}
+
+
+// Internal Functions --
+
+static
+void input_update_keys(input_t *input, const SDL_Event *event) {
+    if (event->type != SDL_KEYDOWN && event->type != SDL_KEYUP) {
+        return;
+    }
+
+    uint32_t scancode = (uint32_t)event->key.keysym.scancode;
+    if (scancode >= SDL_NUM_SCANCODES) {
+        return;
+    }
+    uint64_t bit = (uint64_t)1 << (scancode % 64);
+    if (event->type == SDL_KEYDOWN) {
+        input->keys_down[scancode / 64] |= bit;
+    } else {
+        input->keys_down[scancode / 64] &= ~bit;
+    }
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+int main() {
+    input_t *input = input_create();
+
+    // A burst of key repeat bigger than the ring: everything up to capacity is kept in order
+    SDL_Event event = {0};
+    event.type = SDL_KEYDOWN;
+    event.key.keysym.scancode = 4;
+    for (uint32_t i = 0; i < INPUT_RING_SIZE + 10; i++) {
+        event.key.keysym.sym = (SDL_Keycode)i;
+        input_record(input, &event);
+    }
+
+    uint32_t read = 0;
+    bool in_order = true;
+    input_event_t *ie;
+    while ((ie = input_next(input)) != NULL) {
+        in_order = in_order && ie->event.key.keysym.sym == (SDL_Keycode)read;
+        read += 1;
+    }
+    printf("Read %u events in order: %s, dropped %u\n", read, in_order ? "yes" : "NO", input->dropped);
+
+    bool held = input_key_down(input, 4);
+    event.type = SDL_KEYUP;
+    input_record(input, &event);
+    bool released = !input_key_down(input, 4);
+    printf("Key held: %s, released: %s\n", held ? "yes" : "NO", released ? "yes" : "NO");
+
+    SDL_Delay(5);
+    input_end_frame(input, true);
+    input_latency_t latency = input_latency(input);
+    printf("Latency last %.2f ms, average %.2f ms, max %.2f ms over %u frames\n",
+            latency.last_ms, latency.average_ms, latency.max_ms, latency.samples);
+
+    input_destroy(input);
+
+    return (read == INPUT_RING_SIZE && in_order && held && released && latency.last_ms >= 5.0) ? 0 : 1;
+}
+
+#endif
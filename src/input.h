@@ -0,0 +1,95 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+
+/*
+ * Input - every pending event each frame, timestamped, plus current key state.
+ *
+ * Events are recorded into a fixed-size ring buffer with a high-resolution timestamp and
+ * read back in order, so a burst of typing or key repeat is all handled in the frame it
+ * arrives instead of one event per frame. Recording also keeps a bitset of the keys held
+ * down, indexed by scancode, for constant-time queries.
+ *
+ * The input also measures latency from input to display: the time from the first event
+ * recorded in a frame until that frame is presented.
+ *
+ *  Example usage:
+ *      input_pump(input);      // or input_record() on each event from frame_loop_next_event
+ *      input_event_t *ie;
+ *      while ((ie = input_next(input)) != NULL) {
+ *          ...handle ie->event...
+ *      }
+ *      if (input_key_down(input, SDL_SCANCODE_LSHIFT)) { ... }
+ *      ...compose and present...
+ *      input_end_frame(input, presented);
+ */
+
+
+/** Type definitions **/
+
+#define INPUT_RING_SIZE     256     // power of two
+
+typedef struct {
+    SDL_Event event;
+    uint64_t timestamp;     // SDL_GetPerformanceCounter() when recorded
+} input_event_t;
+
+typedef struct {
+    double last_ms;
+    double average_ms;
+    double max_ms;
+    uint32_t samples;
+} input_latency_t;
+
+typedef struct {
+    input_event_t events[INPUT_RING_SIZE];
+    uint32_t head;                  // next event to read
+    uint32_t count;
+    uint32_t dropped;               // events lost to a full ring
+    uint64_t keys_down[SDL_NUM_SCANCODES / 64];
+    uint64_t frame_first_event;     // timestamp of the first event this frame, 0 if none
+    double latency_total_ms;
+    input_latency_t latency;
+} input_t;
+// Should only use the input via functions, not direct property access
+
+
+/** Public Interface **/
+
+input_t * input_create(void);
+
+void input_destroy(input_t *input);
+
+/**
+ *  Record one event. Returns false if the ring is full and the event was dropped (key
+ *  state is still updated).
+ */
+bool input_record(input_t *input, const SDL_Event *event);
+
+/**
+ *  Record every event SDL has pending. Returns the number recorded.
+ */
+uint32_t input_pump(input_t *input);
+
+/**
+ *  The oldest event not yet read, or NULL if there are none. The pointer is valid until
+ *  the next event is recorded.
+ */
+input_event_t * input_next(input_t *input);
+
+bool input_key_down(const input_t *input, SDL_Scancode scancode);
+
+/**
+ *  Finish the frame. If presented is true, the time since this frame's first event is
+ *  added to the latency figures; a frame that changed nothing on screen isn't counted.
+ */
+void input_end_frame(input_t *input, bool presented);
+
+input_latency_t input_latency(const input_t *input);
+
+
+#endif
@@ -35,6 +35,7 @@ void list_destroy(list_t *list) {
         item = item->next;
         free(item_to_delete);
     }
+    free(list);
 }
 
 
@@ -171,6 +172,8 @@ void * list_remove_first(list_t *list) {
         list_item_t *new_first = list->first->next;
         if (new_first != NULL) {
             new_first->prev = NULL;
+        } else {
+            list->last = NULL;
         }
         list->first = new_first;
 
@@ -189,7 +192,10 @@ void * list_remove_last(list_t *list) {
         list_item_t *item_to_remove = list->last;
         if (list->last->prev != NULL) {
             list->last->prev->next = NULL;
+        } else {
+            list->first = NULL;
         }
+        list->last = item_to_remove->prev;
         
         data = item_to_remove->data;
         free(item_to_remove);
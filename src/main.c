@@ -1,10 +1,13 @@
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 #include "console.h"
+#include "frame_loop.h"
+#include "input.h"
+#include "remote_console.h"
 #include "rex_loader.h"
 
 #define SCREEN_WIDTH	1280
@@ -31,35 +34,47 @@ int main() {
     srand((unsigned) time(&t));
 
 	SDL_Init(SDL_INIT_VIDEO);
-    IMG_Init(IMG_INIT_PNG);
 
 	SDL_Window *window = SDL_CreateWindow("Graphix Test",
 		SDL_WINDOWPOS_UNDEFINED, 
 		SDL_WINDOWPOS_UNDEFINED,
 		SCREEN_WIDTH, SCREEN_HEIGHT,
-		0); //SDL_WINDOW_FULLSCREEN);
+		SDL_WINDOW_ALLOW_HIGHDPI); //SDL_WINDOW_FULLSCREEN);
 
-    console_t *console = console_create(window, SCREEN_WIDTH, SCREEN_HEIGHT, NUM_ROWS, NUM_COLS, 255, "assets/font10x16.png");
+    console_t *console = console_create_with_embedded_font(window, SCREEN_WIDTH, SCREEN_HEIGHT, NUM_ROWS, NUM_COLS, 255);
+    console_set_native_scaling(console, true);
     console_screen_t *screen = console_screen_create(NUM_COLS, NUM_ROWS, 255);
+    console_screen_set_lazy_clear(screen, true);
     
     console_view_t *view = console_view_from_rexfile("./assets/cat.xp");
    
     uint32_t x = 0;
     uint32_t y = 0;
     
+    frame_loop_t *loop = frame_loop_create(console, NUM_COLS, NUM_ROWS, FPS_LIMIT);
+    input_t *input = input_create();
+
+    // Let remote viewers (tools/remote_view) watch the game when asked to
+    const char *remote_socket = getenv("REMOTE_CONSOLE_SOCKET");
+    remote_server_t *remote = (remote_socket != NULL) ? remote_server_create(remote_socket) : NULL;
+
     SDL_Event event;
-    uint32_t timePerFrame = 1000 / FPS_LIMIT;
-    uint32_t frameStart = 0;
-    while (1) {
-        frameStart = SDL_GetTicks();
-
-        if (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                break;
+    bool running = true;
+    while (running) {
+        // Blocks while the screen is static, so an idle game uses next to no CPU
+        while (frame_loop_next_event(loop, &event)) {
+            input_record(input, &event);
+        }
+
+        // Handle every event that arrived, not just one per frame
+        input_event_t *input_event;
+        while ((input_event = input_next(input)) != NULL) {
+            if (input_event->event.type == SDL_QUIT) {
+                running = false;
             }
 
-            if (event.type == SDL_KEYDOWN) {
-                switch (event.key.keysym.sym) {
+            if (input_event->event.type == SDL_KEYDOWN) {
+                switch (input_event->event.key.keysym.sym) {
                     case SDLK_LEFT: x -= 1; break;
                     case SDLK_RIGHT: x += 1; break;
                     case SDLK_UP: y -= 1; break;
@@ -68,27 +83,30 @@ int main() {
             }
         }
 
-        console_clear(console);
         console_screen_clear(screen);
 
         console_screen_put_view_at(screen, view, x, y);
         console_rect_t rect = {10, 30, 10, 2};
         console_screen_put_text_at(screen, "Welcome to the Core", rect, COLOR_FROM_RGBA(0, 255, 0, 255), 255);
-        console_render_screen(console, screen);
-
-        // Limit our top FPS
-        int32_t sleepTime = timePerFrame - (SDL_GetTicks() - frameStart);
-        if (sleepTime > 0) {
-            SDL_Delay(sleepTime);
+        console_rect_t status_rect = {0, NUM_ROWS - 1, NUM_COLS, 1};
+        console_screen_printf_at(screen, status_rect, COLOR_FROM_RGBA(255, 255, 255, 255), 255, "x: %u y: %u", x, y);
+        bool presented = frame_loop_present(loop, screen);
+        input_end_frame(input, presented);
+        if (remote != NULL && presented) {
+            remote_server_publish(remote, screen);
         }
     }
 
+    if (remote != NULL) {
+        remote_server_destroy(remote);
+    }
+    input_destroy(input);
+    frame_loop_destroy(loop);
     console_view_destroy(view);
     console_screen_destroy(screen);
     console_destroy(console);
 	SDL_DestroyWindow(window);
 
-    IMG_Quit();
 	SDL_Quit();
 
 	return 0;
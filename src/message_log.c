@@ -0,0 +1,248 @@
+
+
+#include "message_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Internal Functions --
+
+static uint32_t message_log_start_line(message_log_t *log, uint32_t fg_color, uint32_t bg_color);
+static uint32_t message_log_slot(message_log_t *log, uint32_t line_idx);
+
+
+// External Interface --
+
+message_log_t * message_log_create(uint32_t capacity, uint32_t width) {
+    if (capacity == 0 || width == 0) {
+        return NULL;
+    }
+
+    message_log_line_t *lines = calloc(capacity, sizeof(message_log_line_t));
+    if (lines == NULL) {
+        return NULL;
+    }
+    char *text = calloc((size_t)capacity * width, sizeof(char));
+    if (text == NULL) {
+        free(lines);
+        return NULL;
+    }
+
+    message_log_t *log = calloc(1, sizeof(message_log_t));
+    log->width = width;
+    log->capacity = capacity;
+    log->lines = lines;
+    log->text = text;
+
+    return log;
+}
+
+void message_log_destroy(message_log_t *log) {
+    free(log->text);
+    free(log->lines);
+    free(log);
+}
+
+void message_log_clear(message_log_t *log) {
+    log->count = 0;
+    log->head = 0;
+    log->scroll_offset = 0;
+}
+
+void message_log_add(message_log_t *log, const char *message, uint32_t fg_color, uint32_t bg_color) {
+    // A message with no words would only add a blank line
+    uint32_t idx = 0;
+    while (message[idx] == ' ' || message[idx] == '\t') { idx += 1; }
+    if (message[idx] == '\0') { return; }
+
+    uint32_t added = 1;
+    uint32_t slot = message_log_start_line(log, fg_color, bg_color);
+    message_log_line_t *info = &log->lines[slot];
+    char *line = &log->text[(size_t)slot * log->width];
+
+    while (1) {
+        // Find the start of the next word
+        while (message[idx] == ' ' || message[idx] == '\t') { idx += 1; }
+        if (message[idx] == '\0') { break; }
+
+        uint32_t word_start = idx;
+        while (message[idx] != ' ' && message[idx] != '\t' && message[idx] != '\0') { idx += 1; }
+        uint32_t word_len = idx - word_start;
+
+        // Lay the word out, breaking it up if it is wider than a whole line
+        while (word_len > 0) {
+            if (info->length > 0 && (info->length + 1 + word_len) > log->width) {
+                slot = message_log_start_line(log, fg_color, bg_color);
+                info = &log->lines[slot];
+                line = &log->text[(size_t)slot * log->width];
+                added += 1;
+            }
+            if (info->length > 0) {
+                line[info->length] = ' ';
+                info->length += 1;
+            }
+
+            uint32_t chunk = log->width - info->length;
+            if (chunk > word_len) { chunk = word_len; }
+            memcpy(&line[info->length], &message[word_start], chunk);
+            info->length += chunk;
+            word_start += chunk;
+            word_len -= chunk;
+        }
+    }
+
+    // Keep a scrolled-back view on the lines the reader was looking at
+    if (log->scroll_offset > 0) {
+        log->scroll_offset += added;
+        if (log->scroll_offset >= log->count) {
+            log->scroll_offset = log->count - 1;
+        }
+    }
+}
+
+uint32_t message_log_line_count(message_log_t *log) {
+    return log->count;
+}
+
+void message_log_scroll(message_log_t *log, int32_t line_delta) {
+    int64_t offset = (int64_t)log->scroll_offset + line_delta;
+    if (offset < 0) { offset = 0; }
+    if (log->count == 0) { offset = 0; }
+    else if (offset > (int64_t)log->count - 1) { offset = log->count - 1; }
+    log->scroll_offset = (uint32_t)offset;
+}
+
+void message_log_scroll_to_newest(message_log_t *log) {
+    log->scroll_offset = 0;
+}
+
+void message_log_render(message_log_t *log, console_screen_t *screen, console_rect_t rect) {
+    if (rect.height == 0) { return; }
+
+    // Clamp the scroll position so a full rect of lines is shown when possible
+    uint32_t scroll = log->scroll_offset;
+    uint32_t max_scroll = (log->count > rect.height) ? (log->count - rect.height) : 0;
+    if (scroll > max_scroll) { scroll = max_scroll; }
+
+    // With fewer lines than rows, the lines sit at the bottom of the rect
+    uint32_t visible = (log->count - scroll < rect.height) ? (log->count - scroll) : rect.height;
+    uint32_t first_row = rect.height - visible;
+    uint32_t first_line = log->count - scroll - visible;
+
+    // Rows above the lines are blanked like a screen clear, so nothing drawn earlier shows
+    for (uint32_t row = 0; row < first_row; row++) {
+        console_cell_t *cells = console_screen_cell(screen, rect.x, rect.y + row);
+        for (uint32_t i = 0; i < rect.width; i++) {
+            cells[i].glyph = 0;
+            cells[i].bg_color = screen->bg_color;
+        }
+    }
+
+    for (uint32_t row = first_row; row < rect.height; row++) {
+        uint32_t slot = message_log_slot(log, first_line + (row - first_row));
+        message_log_line_t *info = &log->lines[slot];
+        const char *text = &log->text[(size_t)slot * log->width];
+
+        // The rest of the row after the text is blank in the line's colors
+        uint32_t length = (info->length < rect.width) ? info->length : rect.width;
+        console_cell_t *cells = console_screen_cell(screen, rect.x, rect.y + row);
+        for (uint32_t i = 0; i < rect.width; i++) {
+            uint8_t c = (i < length) ? (uint8_t)text[i] : ' ';
+            cells[i].glyph = (c == ' ') ? 0 : c;
+            cells[i].fg_color = info->fg_color;
+            cells[i].bg_color = info->bg_color;
+        }
+    }
+}
+
+// Internal Functions --
+
+/*
+ * Claim the next slot in the ring buffer as a new, empty line and return the slot index.
+ * Once the log is full this overwrites the oldest line.
+ */
+static
+uint32_t message_log_start_line(message_log_t *log, uint32_t fg_color, uint32_t bg_color) {
+    uint32_t slot = log->head;
+    log->lines[slot].length = 0;
+    log->lines[slot].fg_color = fg_color;
+    log->lines[slot].bg_color = bg_color;
+
+    log->head = (log->head + 1) % log->capacity;
+    if (log->count < log->capacity) {
+        log->count += 1;
+    }
+
+    return slot;
+}
+
+/*
+ * Return the ring buffer slot holding the given line, where line 0 is the oldest stored line.
+ */
+static
+uint32_t message_log_slot(message_log_t *log, uint32_t line_idx) {
+    return (log->head + log->capacity - log->count + line_idx) % log->capacity;
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+int main() {
+    console_screen_t *screen = console_screen_create(20, 4, 0);
+    message_log_t *log = message_log_create(3, 10);
+
+    message_log_add(log, "You hit the rat for 12 damage", 1, 0);
+    printf("Lines after first message (expect 3): %u\n", message_log_line_count(log));
+
+    message_log_add(log, "Extraordinarily long", 2, 0);
+    printf("Lines after overflow (expect 3): %u\n", message_log_line_count(log));
+
+    console_rect_t rect = {0, 0, 10, 4};
+    message_log_render(log, screen, rect);
+    for (uint32_t y = 0; y < 4; y++) {
+        char row[11] = {0};
+        for (uint32_t x = 0; x < 10; x++) {
+            uint32_t g = console_screen_cell(screen, x, y)->glyph;
+            row[x] = (g == 0) ? '.' : (char)g;
+        }
+        printf("|%s|\n", row);
+    }
+
+    message_log_scroll(log, 100);
+    printf("Scroll clamped (expect 2): %u\n", log->scroll_offset);
+
+    // A short log over old drawing: one line at the bottom, every other cell blanked
+    message_log_t *short_log = message_log_create(3, 10);
+    message_log_add(short_log, " \t ", 1, 0);
+    message_log_add(short_log, "hi", 1, 0);
+    printf("Lines after a blank message and \"hi\" (expect 1): %u\n", message_log_line_count(short_log));
+    for (uint32_t i = 0; i < 20 * 4; i++) {
+        screen->cells[i].glyph = '#';
+    }
+    message_log_render(short_log, screen, rect);
+    bool bottom_ok = message_log_line_count(short_log) == 1;
+    for (uint32_t y = 0; y < 4; y++) {
+        char row[11] = {0};
+        for (uint32_t x = 0; x < 10; x++) {
+            uint32_t g = console_screen_cell(screen, x, y)->glyph;
+            row[x] = (g == 0) ? '.' : (char)g;
+        }
+        printf("|%s|\n", row);
+        bottom_ok = bottom_ok && strcmp(row, (y == 3) ? "hi........" : "..........") == 0;
+    }
+    printf("Short log drawn at the bottom over blanked rows: %s\n", bottom_ok ? "yes" : "NO");
+
+    message_log_destroy(short_log);
+    message_log_destroy(log);
+    console_screen_destroy(screen);
+
+    return bottom_ok ? 0 : 1;
+}
+
+#endif
+
@@ -0,0 +1,79 @@
+#ifndef MESSAGE_LOG_H
+#define MESSAGE_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "console.h"
+
+
+/*
+ * Message log - scrollback of game messages for a fixed-width panel.
+ *
+ * Messages are word-wrapped once, when they are added, and stored as
+ * ready-to-draw lines in a fixed-capacity ring buffer. When the buffer is
+ * full the oldest lines are overwritten. Rendering only touches the lines
+ * visible in the target rect, so the cost of a frame does not depend on
+ * how much history has been kept.
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    uint32_t length;        // cells used in this line
+    uint32_t fg_color;
+    uint32_t bg_color;
+} message_log_line_t;
+
+typedef struct {
+    uint32_t width;         // cells per line (wrap width)
+    uint32_t capacity;      // lines retained
+    uint32_t count;         // lines currently stored
+    uint32_t head;          // slot the next line will be written to
+    uint32_t scroll_offset; // lines scrolled back from the newest line
+    message_log_line_t *lines;
+    char *text;             // capacity * width characters, one row per line slot
+} message_log_t;
+// Should only use the log via functions, not direct property access
+
+
+/** Public Interface **/
+
+message_log_t * message_log_create(uint32_t capacity, uint32_t width);
+
+void message_log_destroy(message_log_t *log);
+
+void message_log_clear(message_log_t *log);
+
+/**
+ *  Word-wrap the given message to the log's width and append the resulting
+ *  lines. Words longer than the log width are broken across lines.
+ *
+ *  If the log is scrolled back, the view stays on the lines being read
+ *  rather than jumping to the new message.
+ */
+void message_log_add(message_log_t *log, const char *message, uint32_t fg_color, uint32_t bg_color);
+
+/**
+ *  Number of wrapped lines currently stored (never more than the capacity).
+ */
+uint32_t message_log_line_count(message_log_t *log);
+
+/**
+ *  Scroll the log by the given number of lines. Positive values scroll back
+ *  towards older lines, negative values towards the newest.
+ */
+void message_log_scroll(message_log_t *log, int32_t line_delta);
+
+void message_log_scroll_to_newest(message_log_t *log);
+
+/**
+ *  Draw the lines visible in the given rect, newest line at the bottom.
+ *  Lines are clipped to the rect's width.
+ */
+void message_log_render(message_log_t *log, console_screen_t *screen, console_rect_t rect);
+
+
+#endif
+
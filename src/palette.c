@@ -0,0 +1,312 @@
+
+
+#include "palette.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Internal Functions --
+
+static uint8_t palette_blend_channel(uint32_t from, uint32_t to, uint32_t amount);
+
+
+// External Interface --
+
+/* Palettes */
+
+int32_t palette_index_of(palette_t *palette, uint32_t color) {
+    for (uint32_t i = 0; i < palette->count; i++) {
+        if (palette->colors[i] == color) {
+            return (int32_t)i;
+        }
+    }
+    if (palette->count == PALETTE_SIZE) {
+        return -1;
+    }
+
+    palette->colors[palette->count] = color;
+    palette->count += 1;
+    return (int32_t)(palette->count - 1);
+}
+
+void palette_cycle(palette_t *palette, uint32_t first, uint32_t count, int32_t steps) {
+    if (count == 0 || first >= PALETTE_SIZE || count > PALETTE_SIZE - first) {
+        return;
+    }
+
+    uint32_t shift = (uint32_t)(((steps % (int32_t)count) + (int32_t)count) % (int32_t)count);
+    uint32_t rotated[PALETTE_SIZE];
+    for (uint32_t i = 0; i < count; i++) {
+        rotated[i] = palette->colors[first + ((i + shift) % count)];
+    }
+    memcpy(&palette->colors[first], rotated, count * sizeof(uint32_t));
+}
+
+void palette_fade(palette_t *out, const palette_t *from, const palette_t *to, uint8_t amount) {
+    for (uint32_t i = 0; i < PALETTE_SIZE; i++) {
+        uint32_t a = from->colors[i];
+        uint32_t b = to->colors[i];
+        out->colors[i] = ((uint32_t)palette_blend_channel(RED(a), RED(b), amount) << 24) |
+                         ((uint32_t)palette_blend_channel(GREEN(a), GREEN(b), amount) << 16) |
+                         ((uint32_t)palette_blend_channel(BLUE(a), BLUE(b), amount) << 8) |
+                         palette_blend_channel(ALPHA(a), ALPHA(b), amount);
+    }
+    out->count = (from->count > to->count) ? from->count : to->count;
+}
+
+
+/* Indexed Views */
+
+indexed_view_t * indexed_view_from_view(const console_view_t *view, palette_t *palette) {
+    size_t cell_count = (size_t)view->width * view->height;
+    indexed_cell_t *cells = malloc(cell_count * sizeof(indexed_cell_t));
+    if (cells == NULL) {
+        return NULL;
+    }
+
+    // Neighbouring cells usually share colors, so remember the last lookups
+    uint32_t last_fg = 0, last_bg = 0;
+    int32_t last_fg_index = -1, last_bg_index = -1;
+    for (size_t i = 0; i < cell_count; i++) {
+        const console_cell_t *cell = &view->cells[i];
+        if (last_fg_index < 0 || cell->fg_color != last_fg) {
+            last_fg = cell->fg_color;
+            last_fg_index = palette_index_of(palette, last_fg);
+        }
+        if (last_bg_index < 0 || cell->bg_color != last_bg) {
+            last_bg = cell->bg_color;
+            last_bg_index = palette_index_of(palette, last_bg);
+        }
+        if (last_fg_index < 0 || last_bg_index < 0 || cell->glyph > UINT16_MAX) {
+            free(cells);
+            return NULL;
+        }
+
+        cells[i].glyph = (uint16_t)cell->glyph;
+        cells[i].fg_index = (uint8_t)last_fg_index;
+        cells[i].bg_index = (uint8_t)last_bg_index;
+    }
+
+    indexed_view_t *indexed = calloc(1, sizeof(indexed_view_t));
+    indexed->width = view->width;
+    indexed->height = view->height;
+    indexed->cells = cells;
+
+    return indexed;
+}
+
+indexed_view_t * indexed_view_from_rexfile(const char *filename, palette_t *palette) {
+    console_view_t *view = console_view_from_rexfile(filename);
+    if (view == NULL) {
+        return NULL;
+    }
+
+    indexed_view_t *indexed = indexed_view_from_view(view, palette);
+    console_view_destroy(view);
+
+    return indexed;
+}
+
+void indexed_view_destroy(indexed_view_t *view) {
+    free(view->cells);
+    free(view);
+}
+
+
+/* Indexed Screens */
+
+indexed_screen_t * indexed_screen_create(uint32_t width, uint32_t height, uint8_t bg_index) {
+    indexed_cell_t *cells = calloc((size_t)width * height, sizeof(indexed_cell_t));
+    if (cells == NULL) {
+        return NULL;
+    }
+
+    indexed_screen_t *screen = calloc(1, sizeof(indexed_screen_t));
+    screen->width = width;
+    screen->height = height;
+    screen->bg_index = bg_index;
+    screen->cells = cells;
+
+    return screen;
+}
+
+void indexed_screen_destroy(indexed_screen_t *screen) {
+    free(screen->cells);
+    free(screen);
+}
+
+void indexed_screen_clear(indexed_screen_t *screen) {
+    uint32_t cell_count = screen->width * screen->height;
+    for (uint32_t idx = 0; idx < cell_count; idx++) {
+        screen->cells[idx].glyph = 0;
+        screen->cells[idx].bg_index = screen->bg_index;
+    }
+}
+
+indexed_cell_t * indexed_screen_cell(const indexed_screen_t *screen, uint32_t x, uint32_t y) {
+    return &screen->cells[(y * screen->width) + x];
+}
+
+void indexed_screen_set_cell(indexed_screen_t *screen, uint32_t x, uint32_t y, indexed_cell_t cell) {
+    screen->cells[(y * screen->width) + x] = cell;
+}
+
+void indexed_screen_put_view_at(indexed_screen_t *screen, const indexed_view_t *view, uint32_t x, uint32_t y) {
+    for (uint32_t row = 0; row < view->height; row++) {
+        memcpy(indexed_screen_cell(screen, x, y + row), &view->cells[(size_t)row * view->width],
+                view->width * sizeof(indexed_cell_t));
+    }
+}
+
+void indexed_screen_resolve(const indexed_screen_t *screen, const palette_t *palette, console_screen_t *out) {
+    uint32_t cell_count = screen->width * screen->height;
+    for (uint32_t idx = 0; idx < cell_count; idx++) {
+        const indexed_cell_t *cell = &screen->cells[idx];
+        out->cells[idx].glyph = cell->glyph;
+        out->cells[idx].fg_color = palette->colors[cell->fg_index];
+        out->cells[idx].bg_color = palette->colors[cell->bg_index];
+    }
+    console_screen_touch_rows(out, 0, screen->height);
+}
+
+void indexed_screen_render(console_t *console, const indexed_screen_t *screen, const palette_t *palette) {
+    indexed_screen_draw(console, screen, palette);
+    console_present(console);
+}
+
+void indexed_screen_draw(console_t *console, const indexed_screen_t *screen, const palette_t *palette) {
+    const console_font_t *font = console->font;
+
+    // As console_draw_screen: a pass per font page, changing the texture's color mod
+    // only when the foreground index changes
+    for (uint32_t page = 0; page < font->page_count; page++) {
+        SDL_Texture *texture = font->pages[page];
+        int32_t current_fg = -1;
+
+        for (uint32_t y = 0; y < screen->height; y++) {
+            for (uint32_t x = 0; x < screen->width; x++) {
+                const indexed_cell_t *cell = indexed_screen_cell(screen, x, y);
+                if (cell->glyph >= font->glyph_count || font->glyphs[cell->glyph].page != page) {
+                    continue;
+                }
+                SDL_Rect dst_rect = {x * console->cell_width, y * console->cell_height, console->cell_width, console->cell_height};
+
+                if (cell->fg_index != current_fg) {
+                    uint32_t fg_color = palette->colors[cell->fg_index];
+                    SDL_SetTextureColorMod(texture, RED(fg_color), GREEN(fg_color), BLUE(fg_color));
+                    current_fg = cell->fg_index;
+                }
+                SDL_RenderCopy(console->renderer, texture, &font->glyphs[cell->glyph].src_rect, &dst_rect);
+            }
+        }
+    }
+}
+
+
+// Internal Functions --
+
+static
+uint8_t palette_blend_channel(uint32_t from, uint32_t to, uint32_t amount) {
+    return (uint8_t)(((from * (255 - amount)) + (to * amount) + 127) / 255);
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <time.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+int main() {
+    // A sea with four shades of water, and a boat
+    console_view_t sea = { .width = 200, .height = 100 };
+    sea.cells = malloc(200 * 100 * sizeof(console_cell_t));
+    uint32_t water[4] = { COLOR_FROM_RGBA(0, 0, 128, 255), COLOR_FROM_RGBA(0, 40, 160, 255),
+        COLOR_FROM_RGBA(0, 80, 192, 255), COLOR_FROM_RGBA(40, 120, 224, 255) };
+    for (uint32_t y = 0; y < 100; y++) {
+        for (uint32_t x = 0; x < 200; x++) {
+            sea.cells[(y * 200) + x] = (console_cell_t){ '~', water[(x + y) % 4], COLOR_FROM_RGBA(0, 0, 32, 255) };
+        }
+    }
+    uint32_t boat = COLOR_FROM_RGBA(139, 69, 19, 255);
+    sea.cells[(50 * 200) + 100] = (console_cell_t){ 'B', boat, COLOR_FROM_RGBA(0, 0, 32, 255) };
+
+    palette_t palette = {0};
+    for (uint32_t i = 0; i < 4; i++) { palette_index_of(&palette, water[i]); }
+    indexed_view_t *indexed = indexed_view_from_view(&sea, &palette);
+    printf("Converted: %s, %u palette entries, %zu bytes per cell instead of %zu\n",
+            indexed ? "ok" : "FAILED", palette.count, sizeof(indexed_cell_t), sizeof(console_cell_t));
+
+    indexed_screen_t *screen = indexed_screen_create(200, 100, 0);
+    console_screen_t *resolved = console_screen_create(200, 100, 0);
+    indexed_screen_put_view_at(screen, indexed, 0, 0);
+    indexed_screen_resolve(screen, &palette, resolved);
+    bool round_trip = memcmp(resolved->cells, sea.cells, 200 * 100 * sizeof(console_cell_t)) == 0;
+    printf("Resolves back to the original view: %s\n", round_trip ? "yes" : "NO");
+
+    // Resolving into a lazily cleared screen must leave its rows current, not read back as cleared
+    console_screen_t *lazy = console_screen_create(200, 100, 0);
+    console_screen_set_lazy_clear(lazy, true);
+    console_screen_clear(lazy);
+    indexed_screen_resolve(screen, &palette, lazy);
+    console_cell_t *lazy_cells = malloc(200 * 100 * sizeof(console_cell_t));
+    console_screen_copy_rows(lazy, 0, 100, lazy_cells);
+    bool lazy_resolved = memcmp(lazy_cells, sea.cells, 200 * 100 * sizeof(console_cell_t)) == 0;
+    printf("Resolves into a lazily cleared screen: %s\n", lazy_resolved ? "yes" : "NO");
+    free(lazy_cells);
+    console_screen_destroy(lazy);
+
+    // Glyph codes past 16 bits can't be stored, so the view is refused rather than truncated
+    sea.cells[0].glyph = 70000;
+    indexed_view_t *too_wide = indexed_view_from_view(&sea, &palette);
+    sea.cells[0].glyph = '~';
+    printf("Glyph beyond 16 bits rejected: %s\n", too_wide == NULL ? "yes" : "NO");
+
+    // One shimmer step moves every water cell on to the next shade
+    palette_cycle(&palette, 0, 4, 1);
+    indexed_screen_resolve(screen, &palette, resolved);
+    bool cycled = resolved->cells[0].fg_color == water[1] && resolved->cells[3].fg_color == water[0] &&
+                  resolved->cells[(50 * 200) + 100].fg_color == boat;
+    printf("Palette cycle shifts the water only: %s\n", cycled ? "yes" : "NO");
+
+    palette_t black = {0}, faded;
+    palette_fade(&faded, &palette, &black, 128);
+    printf("Half fade of %08x: %08x\n", palette.colors[3], faded.colors[3]);
+
+    // Screen bandwidth: clear and redraw the whole screen, indexed vs full cells
+    console_screen_t *full_screen = console_screen_create(200, 100, 0);
+    uint32_t iterations = 2000;
+    double start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        console_screen_clear(full_screen);
+        console_screen_put_view_at(full_screen, &sea, 0, 0);
+    }
+    double full_time = now_seconds() - start;
+    start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        indexed_screen_clear(screen);
+        indexed_screen_put_view_at(screen, indexed, 0, 0);
+    }
+    double indexed_time = now_seconds() - start;
+    printf("Clear + full-screen blit: %.1f us full cells, %.1f us indexed\n",
+            full_time * 1e6 / iterations, indexed_time * 1e6 / iterations);
+
+    console_screen_destroy(full_screen);
+    console_screen_destroy(resolved);
+    indexed_screen_destroy(screen);
+    indexed_view_destroy(indexed);
+    free(sea.cells);
+
+    return (round_trip && lazy_resolved && too_wide == NULL && cycled) ? 0 : 1;
+}
+
+#endif
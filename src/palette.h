@@ -0,0 +1,129 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "console.h"
+
+
+/*
+ * Palette-indexed screens and views.
+ *
+ * An indexed cell stores its glyph and two 8-bit indices into a palette of up to 256
+ * colors: 4 bytes rather than a console_cell_t's 12, so clearing, copying and blitting
+ * indexed screens moves a third of the memory. Colors are only looked up when the
+ * screen is rendered, so changing a palette entry recolors every cell using it at once:
+ * palette cycling (water, lava, blinking lights) and fades cost O(palette) per frame
+ * instead of a rewrite of every cell.
+ *
+ *  Example usage:
+ *      palette_t palette = {0};
+ *      indexed_view_t *sea = indexed_view_from_rexfile("sea.xp", &palette);
+ *      ...
+ *      palette_cycle(&palette, first_water_index, 4, 1);    // once per shimmer step
+ *      indexed_screen_put_view_at(screen, sea, 0, 0);
+ *      indexed_screen_render(console, screen, &palette);
+ */
+
+
+#define PALETTE_SIZE    256
+
+/** Type definitions **/
+
+typedef struct {
+    uint32_t count;                     // entries in use
+    uint32_t colors[PALETTE_SIZE];      // RGBA, as console_cell_t colors
+} palette_t;
+
+typedef struct {
+    uint16_t glyph;
+    uint8_t fg_index;
+    uint8_t bg_index;
+} indexed_cell_t;
+
+typedef struct {
+    /* All values measured in cells */
+    uint32_t width;
+    uint32_t height;
+    indexed_cell_t *cells;
+} indexed_view_t;
+
+typedef struct {
+    /* All values measured in cells */
+    uint32_t width;
+    uint32_t height;
+    uint8_t bg_index;
+    indexed_cell_t *cells;
+} indexed_screen_t;
+
+
+/** Public Interface **/
+
+/* Palettes */
+
+/**
+ *  Return the index of the given color, adding it to the palette if it isn't there yet.
+ *  Returns -1 if the palette is full.
+ */
+int32_t palette_index_of(palette_t *palette, uint32_t color);
+
+/**
+ *  Rotate count entries starting at first by steps places (negative steps rotate the
+ *  other way): entry first + i takes the color of entry first + ((i + steps) mod count).
+ */
+void palette_cycle(palette_t *palette, uint32_t first, uint32_t count, int32_t steps);
+
+/**
+ *  Blend every entry between two palettes: amount 0 gives from, 255 gives to.
+ *  out may be the same palette as from or to.
+ */
+void palette_fade(palette_t *out, const palette_t *from, const palette_t *to, uint8_t amount);
+
+
+/* Indexed Views */
+
+/**
+ *  Convert a view, adding its colors to the palette. Returns NULL if the palette
+ *  runs out of entries or a glyph code doesn't fit in 16 bits.
+ */
+indexed_view_t * indexed_view_from_view(const console_view_t *view, palette_t *palette);
+
+indexed_view_t * indexed_view_from_rexfile(const char *filename, palette_t *palette);
+
+void indexed_view_destroy(indexed_view_t *view);
+
+
+/* Indexed Screens */
+
+indexed_screen_t * indexed_screen_create(uint32_t width, uint32_t height, uint8_t bg_index);
+
+void indexed_screen_destroy(indexed_screen_t *screen);
+
+void indexed_screen_clear(indexed_screen_t *screen);
+
+indexed_cell_t * indexed_screen_cell(const indexed_screen_t *screen, uint32_t x, uint32_t y);
+
+void indexed_screen_set_cell(indexed_screen_t *screen, uint32_t x, uint32_t y, indexed_cell_t cell);
+
+void indexed_screen_put_view_at(indexed_screen_t *screen, const indexed_view_t *view, uint32_t x, uint32_t y);
+
+/**
+ *  Write the screen's cells, with colors looked up in the palette, to a console screen
+ *  of the same size (for code that works on console_cell_t, such as REX export).
+ */
+void indexed_screen_resolve(const indexed_screen_t *screen, const palette_t *palette, console_screen_t *out);
+
+/**
+ *  Draw the screen and present the frame like console_render_screen, resolving colors
+ *  through the palette. Equivalent to indexed_screen_draw followed by console_present.
+ */
+void indexed_screen_render(console_t *console, const indexed_screen_t *screen, const palette_t *palette);
+
+/**
+ *  Draw the screen's cells without presenting, like console_draw_screen.
+ */
+void indexed_screen_draw(console_t *console, const indexed_screen_t *screen, const palette_t *palette);
+
+
+#endif
@@ -0,0 +1,659 @@
+
+
+#include "remote_console.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+#ifdef MSG_NOSIGNAL
+#define REMOTE_SEND_FLAGS   MSG_NOSIGNAL
+#else
+#define REMOTE_SEND_FLAGS   0
+#endif
+
+// How long the server thread sleeps between checks that it should still be running
+#define REMOTE_POLL_INTERVAL_MS     250
+
+
+// A viewer as seen from the server
+typedef struct {
+    int fd;
+    remote_buffer_t queue;      // offset is how much has been sent
+    bool needs_keyframe;
+} remote_connection_t;
+
+
+// Internal Functions --
+
+static int remote_server_thread(void *data);
+static void remote_server_accept(remote_server_t *server);
+static void remote_server_broadcast(remote_server_t *server);
+static bool remote_connection_flush(remote_connection_t *connection);
+static void remote_connection_destroy(remote_connection_t *connection);
+static bool remote_encode_delta(const console_screen_t *previous, const console_screen_t *current, remote_buffer_t *buffer);
+static void remote_encode_keyframe(const console_screen_t *screen, remote_buffer_t *buffer);
+static bool remote_client_apply(remote_client_t *client, const remote_message_header_t *header, const uint8_t *payload);
+static void remote_buffer_reserve(remote_buffer_t *buffer, size_t length);
+static void remote_buffer_append(remote_buffer_t *buffer, const void *data, size_t length);
+static void remote_buffer_compact(remote_buffer_t *buffer);
+static bool remote_set_nonblocking(int fd);
+static bool remote_socket_address(const char *socket_path, struct sockaddr_un *address);
+static void remote_screen_copy(console_screen_t **dst, const console_screen_t *src);
+
+
+// External Interface --
+
+/* Server */
+
+remote_server_t * remote_server_create(const char *socket_path) {
+    struct sockaddr_un address;
+    if (!remote_socket_address(socket_path, &address)) {
+        return NULL;
+    }
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        return NULL;
+    }
+    unlink(socket_path);
+    if (bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+            listen(listen_fd, 16) != 0 || !remote_set_nonblocking(listen_fd)) {
+        close(listen_fd);
+        return NULL;
+    }
+
+    int wake_fds[2];
+    if (pipe(wake_fds) != 0) {
+        close(listen_fd);
+        unlink(socket_path);
+        return NULL;
+    }
+    remote_set_nonblocking(wake_fds[0]);
+    remote_set_nonblocking(wake_fds[1]);
+
+    remote_server_t *server = calloc(1, sizeof(remote_server_t));
+    server->listen_fd = listen_fd;
+    server->wake_fds[0] = wake_fds[0];
+    server->wake_fds[1] = wake_fds[1];
+    server->socket_path = strdup(socket_path);
+    server->lock = SDL_CreateMutex();
+    server->clients = list_create((void (*)(void *))remote_connection_destroy);
+
+    SDL_AtomicSet(&server->running, 1);
+    server->thread = SDL_CreateThread(remote_server_thread, "remote_console_server", server);
+    if (server->thread == NULL) {
+        // A server with no thread would never accept anyone
+        remote_server_destroy(server);
+        return NULL;
+    }
+
+    return server;
+}
+
+void remote_server_destroy(remote_server_t *server) {
+    SDL_AtomicSet(&server->running, 0);
+    char wake = 0;
+    if (write(server->wake_fds[1], &wake, 1) < 0) { /* the thread notices within REMOTE_POLL_INTERVAL_MS anyway */ }
+    SDL_WaitThread(server->thread, NULL);
+
+    list_destroy(server->clients);
+    close(server->listen_fd);
+    close(server->wake_fds[0]);
+    close(server->wake_fds[1]);
+    unlink(server->socket_path);
+
+    if (server->published != NULL) { console_screen_destroy(server->published); }
+    if (server->current != NULL) { console_screen_destroy(server->current); }
+    if (server->previous != NULL) { console_screen_destroy(server->previous); }
+    free(server->delta.data);
+    SDL_DestroyMutex(server->lock);
+    free(server->socket_path);
+    free(server);
+}
+
+void remote_server_publish(remote_server_t *server, const console_screen_t *screen) {
+    SDL_LockMutex(server->lock);
+    remote_screen_copy(&server->published, screen);
+    server->published_frame += 1;
+    SDL_UnlockMutex(server->lock);
+
+    // A full pipe already has a wakeup waiting in it
+    char wake = 1;
+    if (write(server->wake_fds[1], &wake, 1) < 0) { /* EAGAIN */ }
+}
+
+uint32_t remote_server_client_count(remote_server_t *server) {
+    return (uint32_t)SDL_AtomicGet(&server->client_count);
+}
+
+
+/* Client */
+
+remote_client_t * remote_client_connect(const char *socket_path) {
+    struct sockaddr_un address;
+    if (!remote_socket_address(socket_path, &address)) {
+        return NULL;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0 || !remote_set_nonblocking(fd)) {
+        close(fd);
+        return NULL;
+    }
+
+    remote_client_t *client = calloc(1, sizeof(remote_client_t));
+    client->fd = fd;
+
+    return client;
+}
+
+void remote_client_destroy(remote_client_t *client) {
+    close(client->fd);
+    if (client->screen != NULL) {
+        console_screen_destroy(client->screen);
+    }
+    free(client->received.data);
+    free(client);
+}
+
+int32_t remote_client_update(remote_client_t *client, uint32_t timeout_ms) {
+    struct pollfd pfd = { client->fd, POLLIN, 0 };
+    if (poll(&pfd, 1, (int)timeout_ms) < 0 && errno != EINTR) {
+        return -1;
+    }
+
+    // Read everything available
+    remote_buffer_t *received = &client->received;
+    while (1) {
+        remote_buffer_reserve(received, 65536);
+        ssize_t n = recv(client->fd, received->data + received->length, received->capacity - received->length, 0);
+        if (n > 0) {
+            received->length += (size_t)n;
+            continue;
+        }
+        if (n == 0) {
+            return -1;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+
+    // Apply each complete message
+    int32_t applied = 0;
+    while (received->length - received->offset >= sizeof(remote_message_header_t)) {
+        remote_message_header_t header;
+        memcpy(&header, received->data + received->offset, sizeof(header));
+        if (header.magic != REMOTE_MESSAGE_MAGIC) {
+            return -1;
+        }
+        if (received->length - received->offset - sizeof(header) < header.size) {
+            break;
+        }
+
+        if (!remote_client_apply(client, &header, received->data + received->offset + sizeof(header))) {
+            return -1;
+        }
+        received->offset += sizeof(header) + header.size;
+        client->messages += 1;
+        applied += 1;
+    }
+    remote_buffer_compact(received);
+
+    return applied;
+}
+
+console_screen_t * remote_client_screen(remote_client_t *client) {
+    return client->screen;
+}
+
+
+// Internal Functions --
+
+static
+int remote_server_thread(void *data) {
+    remote_server_t *server = data;
+    struct pollfd *pfds = NULL;
+    remote_connection_t **connections = NULL;
+    int32_t capacity = 0;
+
+    while (SDL_AtomicGet(&server->running)) {
+        int32_t count = list_count(server->clients);
+        if (count + 2 > capacity) {
+            capacity = (count + 2) * 2;
+            pfds = realloc(pfds, capacity * sizeof(struct pollfd));
+            connections = realloc(connections, capacity * sizeof(remote_connection_t *));
+        }
+
+        pfds[0] = (struct pollfd){ server->wake_fds[0], POLLIN, 0 };
+        pfds[1] = (struct pollfd){ server->listen_fd, POLLIN, 0 };
+        int32_t n = 2;
+        list_iterator_t *iter = list_iterator(server->clients);
+        while (list_iterator_next(iter)) {
+            remote_connection_t *connection = list_iterator_data(iter);
+            short events = POLLIN;
+            if (connection->queue.length > connection->queue.offset) {
+                events |= POLLOUT;
+            }
+            connections[n] = connection;
+            pfds[n++] = (struct pollfd){ connection->fd, events, 0 };
+        }
+        list_iterator_destroy(iter);
+
+        if (poll(pfds, n, REMOTE_POLL_INTERVAL_MS) < 0 && errno != EINTR) {
+            break;
+        }
+
+        if (pfds[0].revents & POLLIN) {
+            char drain[64];
+            while (read(server->wake_fds[0], drain, sizeof(drain)) > 0) {}
+        }
+        if (pfds[1].revents & POLLIN) {
+            remote_server_accept(server);
+        }
+
+        // Viewers only ever send to hang up; anything else they send is ignored
+        for (int32_t i = 2; i < n; i++) {
+            if (pfds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                char discard[256];
+                ssize_t r = recv(connections[i]->fd, discard, sizeof(discard), 0);
+                if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    list_remove_data(server->clients, connections[i]);
+                    remote_connection_destroy(connections[i]);
+                    connections[i] = NULL;
+                }
+            }
+        }
+
+        remote_server_broadcast(server);
+
+        for (int32_t i = 2; i < n; i++) {
+            if (connections[i] != NULL && !remote_connection_flush(connections[i])) {
+                list_remove_data(server->clients, connections[i]);
+                remote_connection_destroy(connections[i]);
+            }
+        }
+        SDL_AtomicSet(&server->client_count, list_count(server->clients));
+    }
+
+    free(pfds);
+    free(connections);
+    return 0;
+}
+
+static
+void remote_server_accept(remote_server_t *server) {
+    int fd;
+    while ((fd = accept(server->listen_fd, NULL, NULL)) >= 0) {
+        if (!remote_set_nonblocking(fd)) {
+            close(fd);
+            continue;
+        }
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+        remote_connection_t *connection = calloc(1, sizeof(remote_connection_t));
+        connection->fd = fd;
+        connection->needs_keyframe = true;
+        list_append(server->clients, connection);
+    }
+}
+
+/*
+ * Pick up the latest published screen, queue its changes for every viewer that is keeping
+ * up, and queue keyframes for viewers that are joining or catching up.
+ */
+static
+void remote_server_broadcast(remote_server_t *server) {
+    SDL_LockMutex(server->lock);
+    bool new_frame = server->published != NULL && server->published_frame != server->broadcast_frame;
+    if (new_frame) {
+        remote_screen_copy(&server->current, server->published);
+        server->broadcast_frame = server->published_frame;
+    }
+    SDL_UnlockMutex(server->lock);
+
+    if (new_frame) {
+        bool resized = !server->have_frame || server->previous->width != server->current->width ||
+                server->previous->height != server->current->height;
+        bool changed = resized || remote_encode_delta(server->previous, server->current, &server->delta);
+
+        list_iterator_t *iter = list_iterator(server->clients);
+        while (changed && list_iterator_next(iter)) {
+            remote_connection_t *connection = list_iterator_data(iter);
+            if (connection->needs_keyframe) {
+                continue;
+            }
+            if (resized || connection->queue.length - connection->queue.offset + server->delta.length > REMOTE_CLIENT_QUEUE_LIMIT) {
+                connection->needs_keyframe = true;
+                if (!resized) {
+                    SDL_AtomicAdd(&server->keyframe_drops, 1);
+                }
+                continue;
+            }
+            remote_buffer_append(&connection->queue, server->delta.data, server->delta.length);
+        }
+        list_iterator_destroy(iter);
+
+        console_screen_t *swap = server->previous;
+        server->previous = server->current;
+        server->current = swap;
+        server->have_frame = true;
+    }
+    if (!server->have_frame) {
+        return;
+    }
+
+    // A keyframe goes out once everything queued before it has been sent, so messages
+    // are never cut short
+    list_iterator_t *iter = list_iterator(server->clients);
+    while (list_iterator_next(iter)) {
+        remote_connection_t *connection = list_iterator_data(iter);
+        if (connection->needs_keyframe && connection->queue.offset == connection->queue.length) {
+            remote_encode_keyframe(server->previous, &connection->queue);
+            connection->needs_keyframe = false;
+        }
+    }
+    list_iterator_destroy(iter);
+}
+
+/*
+ * Send as much of the connection's queue as the socket takes. Returns false if the
+ * viewer has gone away.
+ */
+static
+bool remote_connection_flush(remote_connection_t *connection) {
+    remote_buffer_t *queue = &connection->queue;
+    while (queue->offset < queue->length) {
+        ssize_t n = send(connection->fd, queue->data + queue->offset, queue->length - queue->offset, REMOTE_SEND_FLAGS);
+        if (n > 0) {
+            queue->offset += (size_t)n;
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        return false;
+    }
+    remote_buffer_compact(queue);
+
+    return true;
+}
+
+static
+void remote_connection_destroy(remote_connection_t *connection) {
+    close(connection->fd);
+    free(connection->queue.data);
+    free(connection);
+}
+
+/*
+ * Encode the runs of cells that differ between two screens of the same size as a delta
+ * message. Returns false, leaving the buffer empty, if nothing changed.
+ */
+static
+bool remote_encode_delta(const console_screen_t *previous, const console_screen_t *current, remote_buffer_t *buffer) {
+    buffer->length = 0;
+    buffer->offset = 0;
+
+    remote_message_header_t header = { REMOTE_MESSAGE_MAGIC, REMOTE_MESSAGE_DELTA,
+            current->width, current->height, current->bg_color, 0, 0 };
+    remote_buffer_append(buffer, &header, sizeof(header));
+
+    uint32_t cell_count = current->width * current->height;
+    const console_cell_t *before = previous->cells;
+    const console_cell_t *after = current->cells;
+    for (uint32_t i = 0; i < cell_count; ) {
+        if (memcmp(&before[i], &after[i], sizeof(console_cell_t)) == 0) {
+            i += 1;
+            continue;
+        }
+
+        uint32_t first = i;
+        while (i < cell_count && memcmp(&before[i], &after[i], sizeof(console_cell_t)) != 0) {
+            i += 1;
+        }
+        uint32_t run[2] = { first, i - first };
+        remote_buffer_append(buffer, run, sizeof(run));
+        remote_buffer_append(buffer, &after[first], run[1] * sizeof(console_cell_t));
+        header.count += 1;
+    }
+
+    if (header.count == 0 && previous->bg_color == current->bg_color) {
+        buffer->length = 0;
+        return false;
+    }
+    header.size = (uint32_t)(buffer->length - sizeof(header));
+    memcpy(buffer->data, &header, sizeof(header));
+
+    return true;
+}
+
+static
+void remote_encode_keyframe(const console_screen_t *screen, remote_buffer_t *buffer) {
+    uint32_t cell_count = screen->width * screen->height;
+    remote_message_header_t header = { REMOTE_MESSAGE_MAGIC, REMOTE_MESSAGE_KEYFRAME,
+            screen->width, screen->height, screen->bg_color, cell_count, cell_count * (uint32_t)sizeof(console_cell_t) };
+    remote_buffer_append(buffer, &header, sizeof(header));
+    remote_buffer_append(buffer, screen->cells, header.size);
+}
+
+/*
+ * Apply one message to the client's screen. Returns false if the message is malformed.
+ */
+static
+bool remote_client_apply(remote_client_t *client, const remote_message_header_t *header, const uint8_t *payload) {
+    uint64_t cell_count = (uint64_t)header->width * header->height;
+
+    if (header->type == REMOTE_MESSAGE_KEYFRAME) {
+        if (header->count != cell_count || header->size != cell_count * sizeof(console_cell_t)) {
+            return false;
+        }
+        console_screen_t *screen = client->screen;
+        if (screen == NULL || screen->width != header->width || screen->height != header->height) {
+            if (screen != NULL) {
+                console_screen_destroy(screen);
+            }
+            screen = client->screen = console_screen_create(header->width, header->height, header->bg_color);
+        }
+        screen->bg_color = header->bg_color;
+        memcpy(screen->cells, payload, header->size);
+        return true;
+    }
+
+    if (header->type != REMOTE_MESSAGE_DELTA) {
+        return false;
+    }
+    console_screen_t *screen = client->screen;
+    if (screen == NULL || screen->width != header->width || screen->height != header->height) {
+        return false;
+    }
+
+    screen->bg_color = header->bg_color;
+    const uint8_t *end = payload + header->size;
+    for (uint32_t r = 0; r < header->count; r++) {
+        uint32_t run[2];
+        if ((size_t)(end - payload) < sizeof(run)) {
+            return false;
+        }
+        memcpy(run, payload, sizeof(run));
+        payload += sizeof(run);
+
+        size_t run_bytes = (size_t)run[1] * sizeof(console_cell_t);
+        if ((uint64_t)run[0] + run[1] > cell_count || (size_t)(end - payload) < run_bytes) {
+            return false;
+        }
+        memcpy(&screen->cells[run[0]], payload, run_bytes);
+        payload += run_bytes;
+    }
+
+    return true;
+}
+
+/*
+ * Make room for at least length more bytes.
+ */
+static
+void remote_buffer_reserve(remote_buffer_t *buffer, size_t length) {
+    if (buffer->length + length <= buffer->capacity) {
+        return;
+    }
+    size_t capacity = (buffer->capacity > 0) ? buffer->capacity : 4096;
+    while (capacity < buffer->length + length) {
+        capacity *= 2;
+    }
+    buffer->data = realloc(buffer->data, capacity);
+    buffer->capacity = capacity;
+}
+
+static
+void remote_buffer_append(remote_buffer_t *buffer, const void *data, size_t length) {
+    remote_buffer_reserve(buffer, length);
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+}
+
+/*
+ * Drop the bytes before the buffer's offset.
+ */
+static
+void remote_buffer_compact(remote_buffer_t *buffer) {
+    if (buffer->offset == 0) {
+        return;
+    }
+    memmove(buffer->data, buffer->data + buffer->offset, buffer->length - buffer->offset);
+    buffer->length -= buffer->offset;
+    buffer->offset = 0;
+}
+
+static
+bool remote_set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+static
+bool remote_socket_address(const char *socket_path, struct sockaddr_un *address) {
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address->sun_path)) {
+        return false;
+    }
+    strcpy(address->sun_path, socket_path);
+    return true;
+}
+
+/*
+ * Copy a screen's size and cells into *dst, reallocating it if the size differs.
+ */
+static
+void remote_screen_copy(console_screen_t **dst, const console_screen_t *src) {
+    if (*dst == NULL || (*dst)->width != src->width || (*dst)->height != src->height) {
+        if (*dst != NULL) {
+            console_screen_destroy(*dst);
+        }
+        *dst = console_screen_create(src->width, src->height, src->bg_color);
+    }
+    (*dst)->bg_color = src->bg_color;
+    console_screen_copy_rows(src, 0, src->height, (*dst)->cells);
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <time.h>
+
+#define TEST_SOCKET     "/tmp/remote_console_test.sock"
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1e6);
+}
+
+static bool screens_match(const console_screen_t *a, const console_screen_t *b) {
+    return a != NULL && a->width == b->width && a->height == b->height &&
+        memcmp(a->cells, b->cells, (size_t)a->width * a->height * sizeof(console_cell_t)) == 0;
+}
+
+// Keep updating the client until it shows the screen, or give up after two seconds
+static bool catch_up(remote_client_t *client, const console_screen_t *screen) {
+    double start = now_ms();
+    while (now_ms() - start < 2000.0) {
+        if (remote_client_update(client, 10) < 0) { return false; }
+        if (screens_match(remote_client_screen(client), screen)) { return true; }
+    }
+    return false;
+}
+
+int main() {
+    remote_server_t *server = remote_server_create(TEST_SOCKET);
+    if (server == NULL) {
+        printf("Unable to create server at %s\n", TEST_SOCKET);
+        return 1;
+    }
+    console_screen_t *screen = console_screen_create(128, 48, 255);
+
+    remote_client_t *fast = remote_client_connect(TEST_SOCKET);
+    remote_client_t *slow = remote_client_connect(TEST_SOCKET);
+
+    // The fast viewer reads every frame; the slow one reads nothing until the end
+    double worst_publish = 0;
+    for (uint32_t frame = 0; frame < 300; frame++) {
+        for (uint32_t i = 0; i < screen->width * screen->height; i++) {
+            screen->cells[i] = (console_cell_t){ (i + frame) % 256, frame * 7919 + i, 255 };
+        }
+        console_screen_printf_at(screen, (console_rect_t){0, 0, 20, 1}, 0xffffffff, 255, "frame %u", frame);
+
+        double start = now_ms();
+        remote_server_publish(server, screen);
+        double elapsed = now_ms() - start;
+        if (elapsed > worst_publish) { worst_publish = elapsed; }
+
+        remote_client_update(fast, 1);
+    }
+
+    bool fast_ok = catch_up(fast, screen);
+    bool slow_ok = catch_up(slow, screen);
+    uint32_t drops = (uint32_t)SDL_AtomicGet(&server->keyframe_drops);
+    printf("Viewers: %u, fast viewer in sync: %s, slow viewer resynced: %s\n",
+            remote_server_client_count(server), fast_ok ? "yes" : "NO", slow_ok ? "yes" : "NO");
+    printf("Slow viewer dropped to keyframes %u times, worst publish %.3f ms\n", drops, worst_publish);
+
+    // Small changes go out as small deltas
+    console_screen_put_text_at(screen, "hello", (console_rect_t){5, 5, 10, 1}, 0xff0000ff, 255);
+    remote_server_publish(server, screen);
+    bool delta_ok = catch_up(fast, screen);
+    printf("Small change applied: %s\n", delta_ok ? "yes" : "NO");
+
+    remote_client_destroy(slow);
+    remote_client_destroy(fast);
+    console_screen_destroy(screen);
+    remote_server_destroy(server);
+
+    return (fast_ok && slow_ok && delta_ok && drops > 0 && worst_publish < 5.0) ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef REMOTE_CONSOLE_H
+#define REMOTE_CONSOLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+#include "console.h"
+#include "list.h"
+
+
+/*
+ * Remote console - watch a running game's screen from other processes.
+ *
+ * A server listens on a Unix domain socket. Each frame the game thread publishes its
+ * screen, which is a copy under a lock and nothing more. A server thread diffs each
+ * published screen against the previous one and queues the changed runs of cells for
+ * every connected viewer. A viewer gets a keyframe (the whole screen) when it joins. A
+ * viewer that falls behind gets no more deltas. Once its queue has drained it gets a
+ * fresh keyframe. Slow viewers never hold up the game or each other.
+ *
+ * Viewers use a remote client, which applies the messages to its own copy of the
+ * screen (see tools/remote_view.c).
+ *
+ * Messages are a remote_message_header_t followed by its payload, in host byte order:
+ *      keyframe: width * height console_cell_t
+ *      delta:    count runs of { uint32_t first_cell, uint32_t cell_count, cells... }
+ *
+ *  Example usage:
+ *      remote_server_t *server = remote_server_create("/tmp/game.sock");
+ *      ...each frame...
+ *      remote_server_publish(server, screen);
+ */
+
+
+/** Type definitions **/
+
+#define REMOTE_MESSAGE_MAGIC        0x314e4352      // "RCN1"
+#define REMOTE_CLIENT_QUEUE_LIMIT   (1024 * 1024)   // bytes queued before a viewer drops to keyframes
+
+typedef enum {
+    REMOTE_MESSAGE_KEYFRAME = 1,
+    REMOTE_MESSAGE_DELTA = 2
+} remote_message_type_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t type;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bg_color;
+    uint32_t count;     // keyframe: cells, delta: runs
+    uint32_t size;      // payload bytes that follow
+} remote_message_header_t;
+
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+    size_t offset;      // bytes already sent or parsed
+} remote_buffer_t;
+
+typedef struct {
+    int listen_fd;
+    int wake_fds[2];                // publish wakes the server thread through this pipe
+    char *socket_path;
+    SDL_Thread *thread;
+    SDL_atomic_t running;
+
+    SDL_mutex *lock;
+    console_screen_t *published;    // latest screen from the game thread, under lock
+    uint32_t published_frame;       // under lock
+
+    // Server thread only
+    console_screen_t *current;
+    console_screen_t *previous;     // last screen broadcast; what every in-sync viewer shows
+    uint32_t broadcast_frame;
+    bool have_frame;
+    remote_buffer_t delta;
+    list_t *clients;
+
+    SDL_atomic_t client_count;
+    SDL_atomic_t keyframe_drops;    // times a viewer fell behind and was dropped to keyframes
+} remote_server_t;
+// Should only use the server via functions, not direct property access
+
+typedef struct {
+    int fd;
+    remote_buffer_t received;
+    console_screen_t *screen;       // NULL until the first keyframe arrives
+    uint32_t messages;
+} remote_client_t;
+// Should only use the client via functions, not direct property access
+
+
+/** Public Interface **/
+
+/**
+ *  Start a server on a Unix domain socket at the given path, replacing any stale socket
+ *  file there. Returns NULL if the socket can't be set up.
+ */
+remote_server_t * remote_server_create(const char *socket_path);
+
+/**
+ *  Stop the server, disconnect every viewer and remove the socket file.
+ */
+void remote_server_destroy(remote_server_t *server);
+
+/**
+ *  Publish the screen to viewers. Copies the cells and returns; never waits on viewers.
+ */
+void remote_server_publish(remote_server_t *server, const console_screen_t *screen);
+
+uint32_t remote_server_client_count(remote_server_t *server);
+
+/**
+ *  Connect to a server. Returns NULL if there's no server at the path.
+ */
+remote_client_t * remote_client_connect(const char *socket_path);
+
+void remote_client_destroy(remote_client_t *client);
+
+/**
+ *  Wait up to timeout_ms for data, then apply every complete message received. Returns the
+ *  number of messages applied, or -1 if the server went away or sent something invalid.
+ */
+int32_t remote_client_update(remote_client_t *client, uint32_t timeout_ms);
+
+/**
+ *  The viewer's copy of the remote screen, or NULL before the first keyframe.
+ */
+console_screen_t * remote_client_screen(remote_client_t *client);
+
+
+#endif
@@ -0,0 +1,217 @@
+
+
+#include "rex_export.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rex_loader.h"
+
+
+// Side of the square blocks used when transposing row-major cells into column-major tiles
+#define EXPORT_TRANSPOSE_BLOCK_SIZE     32
+
+
+// Internal Functions --
+
+static rex_export_t * rex_export_start(console_cell_t *snapshot, uint32_t width, uint32_t height, const char *filename, int level);
+static int rex_export_worker(void *data);
+
+
+// External Interface --
+
+// Snapshots are the only work done on the caller's thread
+
+rex_export_t * rex_export_screen(const console_screen_t *screen, const char *filename, int level) {
+    console_cell_t *snapshot = malloc((size_t)screen->width * screen->height * sizeof(console_cell_t));
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    // Copied by rows so lazily cleared rows come out cleared
+    console_screen_copy_rows(screen, 0, screen->height, snapshot);
+    return rex_export_start(snapshot, screen->width, screen->height, filename, level);
+}
+
+rex_export_t * rex_export_view(const console_view_t *view, const char *filename, int level) {
+    size_t cells_size = (size_t)view->width * view->height * sizeof(console_cell_t);
+    console_cell_t *snapshot = malloc(cells_size);
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    memcpy(snapshot, view->cells, cells_size);
+    return rex_export_start(snapshot, view->width, view->height, filename, level);
+}
+
+bool rex_export_done(rex_export_t *export) {
+    return SDL_AtomicGet(&export->done) != 0;
+}
+
+bool rex_export_wait(rex_export_t *export) {
+    if (export->thread != NULL) {
+        SDL_WaitThread(export->thread, NULL);
+        export->thread = NULL;
+    }
+    return export->succeeded;
+}
+
+const char * rex_export_error(rex_export_t *export) {
+    return export->error;
+}
+
+void rex_export_destroy(rex_export_t *export) {
+    rex_export_wait(export);
+    free(export->filename);
+    free(export);
+}
+
+void rex_export_cells_to_tiles(const console_cell_t *cells, uint32_t width, uint32_t height, rex_tile_t *tiles) {
+    // Square blocks keep both the cell reads and the tile writes within a few cache lines
+    for (uint32_t block_x = 0; block_x < width; block_x += EXPORT_TRANSPOSE_BLOCK_SIZE) {
+        uint32_t end_x = (block_x + EXPORT_TRANSPOSE_BLOCK_SIZE < width) ? block_x + EXPORT_TRANSPOSE_BLOCK_SIZE : width;
+        for (uint32_t block_y = 0; block_y < height; block_y += EXPORT_TRANSPOSE_BLOCK_SIZE) {
+            uint32_t end_y = (block_y + EXPORT_TRANSPOSE_BLOCK_SIZE < height) ? block_y + EXPORT_TRANSPOSE_BLOCK_SIZE : height;
+
+            for (uint32_t y = block_y; y < end_y; y++) {
+                const console_cell_t *cell = &cells[((size_t)y * width) + block_x];
+                rex_tile_t *tile = &tiles[((size_t)block_x * height) + y];
+                for (uint32_t x = block_x; x < end_x; x++, cell++, tile += height) {
+                    bool transparent = (ALPHA(cell->bg_color) == 0);
+                    // REX char codes are 32-bit little-endian; the loader only reads the low byte
+                    tile->char_code = (uint8_t)cell->glyph;
+                    tile->unused_1 = (uint8_t)(cell->glyph >> 8);
+                    tile->unused_2 = (uint8_t)(cell->glyph >> 16);
+                    tile->unused_3 = (uint8_t)(cell->glyph >> 24);
+                    tile->fg_red = RED(cell->fg_color);
+                    tile->fg_green = GREEN(cell->fg_color);
+                    tile->fg_blue = BLUE(cell->fg_color);
+                    tile->bg_red = transparent ? 255 : RED(cell->bg_color);
+                    tile->bg_green = transparent ? 0 : GREEN(cell->bg_color);
+                    tile->bg_blue = transparent ? 255 : BLUE(cell->bg_color);
+                }
+            }
+        }
+    }
+}
+
+
+// Internal Functions --
+
+/*
+ * Start writing the snapshot on a background thread. Takes ownership of the snapshot.
+ */
+static
+rex_export_t * rex_export_start(console_cell_t *snapshot, uint32_t width, uint32_t height, const char *filename, int level) {
+    rex_export_t *export = calloc(1, sizeof(rex_export_t));
+    export->filename = strdup(filename);
+    export->level = level;
+    export->width = width;
+    export->height = height;
+    export->cells = snapshot;
+
+    export->thread = SDL_CreateThread(rex_export_worker, "rex_export", export);
+    if (export->thread == NULL) {
+        free(snapshot);
+        free(export->filename);
+        free(export);
+        return NULL;
+    }
+
+    return export;
+}
+
+static
+int rex_export_worker(void *data) {
+    rex_export_t *export = data;
+
+    rex_tile_layer_t layer = { export->width, export->height, NULL };
+    layer.tiles = malloc((size_t)export->width * export->height * sizeof(rex_tile_t));
+    if (layer.tiles != NULL) {
+        rex_export_cells_to_tiles(export->cells, export->width, export->height, layer.tiles);
+    }
+    free(export->cells);
+    export->cells = NULL;
+
+    if (layer.tiles == NULL) {
+        snprintf(export->error, sizeof(export->error), "%s: out of memory", export->filename);
+    } else {
+        rex_tile_map_t map = { (uint32_t)-1, 1, export->width, export->height, &layer };
+        export->succeeded = rex_save_tile_map(&map, export->filename, export->level);
+        if (!export->succeeded) {
+            snprintf(export->error, sizeof(export->error), "%s", rex_get_error());
+        }
+        free(layer.tiles);
+    }
+
+    SDL_AtomicSet(&export->done, 1);
+    return 0;
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <time.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+int main() {
+    const char *filename = "/tmp/rex_export_test.xp";
+
+    console_screen_t *screen = console_screen_create(1500, 1000, COLOR_FROM_RGBA(0, 0, 0, 0));
+    for (uint32_t y = 0; y < screen->height; y++) {
+        for (uint32_t x = 0; x < screen->width; x++) {
+            // Leave every seventh cell transparent
+            if ((x + y) % 7 == 0) { continue; }
+            console_cell_t cell = { (x * 31 + y) % 256, COLOR_FROM_RGBA(x % 256, y % 256, 7, 255),
+                COLOR_FROM_RGBA(y % 200, 3, x % 256, 255) };
+            console_screen_set_cell(screen, x, y, cell);
+        }
+    }
+
+    double start = now_seconds();
+    rex_export_t *export = rex_export_screen(screen, filename, 6);
+    double started = now_seconds();
+
+    // The screen can be reused straight away while the export runs
+    console_screen_clear(screen);
+    uint32_t frames = 0;
+    while (!rex_export_done(export)) {
+        frames += 1;
+        SDL_Delay(1);
+    }
+    bool saved = rex_export_wait(export);
+    printf("Export started in %.2f ms, finished in %.2f ms (%u frames polled): %s\n",
+            (started - start) * 1000.0, (now_seconds() - start) * 1000.0, frames,
+            saved ? "ok" : rex_export_error(export));
+    rex_export_destroy(export);
+
+    // Reload and check every cell; transparent cells come back as the blank cell
+    console_view_t *view = console_view_from_rexfile(filename);
+    bool match = (view != NULL) && view->width == 1500 && view->height == 1000;
+    for (uint32_t y = 0; match && y < 1000; y++) {
+        for (uint32_t x = 0; match && x < 1500; x++) {
+            console_cell_t expected = {0, COLOR_FROM_RGBA(0, 0, 0, 255), COLOR_FROM_RGBA(0, 0, 0, 255)};
+            if ((x + y) % 7 != 0) {
+                expected = (console_cell_t){ (x * 31 + y) % 256, COLOR_FROM_RGBA(x % 256, y % 256, 7, 255),
+                    COLOR_FROM_RGBA(y % 200, 3, x % 256, 255) };
+            }
+            match = (memcmp(&view->cells[(y * 1500) + x], &expected, sizeof(expected)) == 0);
+        }
+    }
+    printf("Round trip through %s: %s\n", filename, match ? "match" : "DIFFER");
+
+    if (view) { console_view_destroy(view); }
+    console_screen_destroy(screen);
+    remove(filename);
+
+    return match ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef REX_EXPORT_H
+#define REX_EXPORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+#include "console.h"
+
+
+/*
+ * REX export - save screens and views as REXPaint .xp files without stalling the game.
+ *
+ * Starting an export only copies the cells; converting them to REX's column-major tile
+ * layout and compressing the result happen on a background thread. Poll rex_export_done()
+ * from the game loop (or call rex_export_wait()) and destroy the export once it finishes.
+ *
+ * Cells with a fully transparent background are written as REXPaint's transparent tile
+ * (a 255,0,255 background). Exported files have a single layer.
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    char *filename;
+    int level;
+    uint32_t width;
+    uint32_t height;
+    console_cell_t *cells;      // snapshot taken when the export started; freed by the export thread
+    SDL_Thread *thread;
+    SDL_atomic_t done;
+    bool succeeded;
+    char error[256];
+} rex_export_t;
+// Should only use the export via functions, not direct property access
+
+
+/** Public Interface **/
+
+/**
+ *  Start saving a snapshot of the screen / view to the given file, compressed at the given
+ *  zlib level (0-9, or -1 for zlib's default). The source may be changed or destroyed as
+ *  soon as this returns. Returns NULL if the snapshot can't be taken.
+ */
+rex_export_t * rex_export_screen(const console_screen_t *screen, const char *filename, int level);
+rex_export_t * rex_export_view(const console_view_t *view, const char *filename, int level);
+
+/**
+ *  Whether the export has finished (successfully or not). Never blocks.
+ */
+bool rex_export_done(rex_export_t *export);
+
+/**
+ *  Block until the export has finished. Returns true if the file was written.
+ */
+bool rex_export_wait(rex_export_t *export);
+
+/**
+ *  Why a finished export failed.
+ */
+const char * rex_export_error(rex_export_t *export);
+
+/**
+ *  Wait for the export to finish if it hasn't, then destroy it.
+ */
+void rex_export_destroy(rex_export_t *export);
+
+/**
+ *  Convert row-major cells to a column-major REX tile layer. The tiles array must hold
+ *  width * height tiles.
+ */
+void rex_export_cells_to_tiles(const console_cell_t *cells, uint32_t width, uint32_t height, rex_tile_t *tiles);
+
+
+#endif
@@ -1,64 +1,475 @@
 
+
 #include "rex_loader.h"
 
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
 #include "../lib/zlib.h"
 
 
+// Tiles are read straight from the stream into rex_tile_t arrays, so the struct must match the file layout
+_Static_assert(sizeof(rex_tile_t) == 10, "rex_tile_t must be packed to the 10-byte REX tile layout");
+
+#define REX_READ_CHUNK_SIZE     (1u << 30)   // gzread/gzwrite/inflate take unsigned lengths
+#define REX_GZ_BUFFER_SIZE      (128 * 1024)
+
+typedef enum {
+    REX_SOURCE_GZ_FILE,     // a file read through gzread (which also passes uncompressed files through)
+    REX_SOURCE_GZ_MEMORY,   // a gzip stream in memory, inflated directly
+    REX_SOURCE_RAW_MEMORY,  // uncompressed data in memory
+} rex_source_t;
+
+typedef struct {
+    rex_source_t source;
+    gzFile file;
+    z_stream inflater;
+    const uint8_t *data;    // in-memory input not yet handed to the inflater / copied out
+    size_t remaining;
+    bool have_stream_size;  // stream_size is known up front (from the gzip trailer)
+    uint32_t stream_size;   // uncompressed size, mod 2^32
+    const char *name;       // used in error messages
+} rex_reader_t;
+
+struct rex_stream_s {
+    rex_reader_t reader;
+    uint32_t version;
+    uint32_t layer_count;
+    uint32_t width;
+    uint32_t height;
+    int32_t layer;              // layer currently being read; -1 before the first
+    uint64_t tiles_remaining;   // tiles not yet read from the current layer
+};
+
+// Region index - see rex_index_build()
+#define REX_INDEX_MAGIC         "RXI1"
+#define REX_INDEX_VERSION       1
+#define REX_INDEX_WINDOW_SIZE   32768       // deflate's maximum back-reference distance
+#define REX_INDEX_INPUT_SIZE    (16 * 1024)
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;        // 0x01020304 as written by the host that created the file
+    uint32_t checkpoint_count;
+    uint64_t source_size;       // size of the indexed file, to detect a stale index
+    int64_t source_mtime;
+    uint32_t span;
+    uint32_t compressed;        // 0 if the indexed file is stored uncompressed
+    uint32_t map_version;
+    uint32_t layer_count;
+    uint32_t width;
+    uint32_t height;
+} rex_index_header_t;
+
+/*
+ * A point in the compressed stream where inflation can restart: the position of a deflate
+ * block boundary in both streams, the bits of the boundary byte already consumed, and the
+ * 32 KB of output preceding it (the dictionary the following blocks may refer back into).
+ */
+typedef struct {
+    uint64_t out_offset;
+    uint64_t in_offset;
+    uint32_t bits;
+    uint32_t reserved;
+    uint8_t window[REX_INDEX_WINDOW_SIZE];
+} rex_index_checkpoint_t;
+
+struct rex_index_s {
+    char *filename;
+    rex_index_header_t header;
+    rex_index_checkpoint_t *checkpoints;
+};
+
+
+// Internal Functions --
+
+static void rex_set_error(const char *format, ...);
+static bool rex_reader_open_file(rex_reader_t *reader, const char *filename);
+static bool rex_reader_open_memory(rex_reader_t *reader, const void *data, size_t size);
+static int64_t rex_reader_read(rex_reader_t *reader, void *buffer, uint64_t length);
+static void rex_reader_close(rex_reader_t *reader);
+static bool rex_read_fully(rex_reader_t *reader, void *buffer, uint64_t length);
+static rex_stream_t *rex_stream_start(rex_stream_t *stream);
+static rex_tile_map_t *rex_load_tile_map_from_stream(rex_stream_t *stream);
+static bool rex_read_stream_size(const char *filename, uint32_t *size);
+static bool rex_write_fully(gzFile file, const void *buffer, uint64_t length);
+static bool rex_index_stat_source(FILE *file, uint64_t *size, int64_t *mtime);
+static bool rex_index_add_checkpoints(rex_index_t *index, FILE *file);
+static bool rex_index_read(const rex_index_t *index, uint64_t offset, void *buffer, uint64_t length);
+
+// Per thread, so loads on worker threads don't overwrite each other's errors
+static _Thread_local char rex_error[256] = "";
+
+
+// External Interface --
 
 rex_tile_map_t *rex_load_tile_map(const char *filename) {
+    rex_stream_t *stream = rex_stream_open(filename);
+    if (!stream) {
+        return NULL;
+    }
+
+    rex_tile_map_t *tile_map = rex_load_tile_map_from_stream(stream);
+    rex_stream_close(stream);
+
+    return tile_map;
+}
+
+rex_tile_map_t *rex_load_tile_map_from_memory(const void *data, size_t size) {
+    rex_stream_t *stream = rex_stream_open_memory(data, size);
+    if (!stream) {
+        return NULL;
+    }
+
+    rex_tile_map_t *tile_map = rex_load_tile_map_from_stream(stream);
+    rex_stream_close(stream);
+
+    return tile_map;
+}
+
+void rex_destroy_tile_map(rex_tile_map_t *map) {
+    if (map->layers != NULL) {
+        for (uint32_t l = 0; l < map->layer_count; l++) {
+            free(map->layers[l].tiles);
+        }
+    }
+    free(map->layers);
+    free(map);
+}
+
+const char *rex_get_error(void) {
+    return rex_error;
+}
+
+rex_stream_t *rex_stream_open(const char *filename) {
+    rex_stream_t *stream = calloc(1, sizeof(rex_stream_t));
+    if (!rex_reader_open_file(&stream->reader, filename)) {
+        free(stream);
+        return NULL;
+    }
+
+    return rex_stream_start(stream);
+}
+
+rex_stream_t *rex_stream_open_memory(const void *data, size_t size) {
+    rex_stream_t *stream = calloc(1, sizeof(rex_stream_t));
+    if (!rex_reader_open_memory(&stream->reader, data, size)) {
+        free(stream);
+        return NULL;
+    }
+
+    return rex_stream_start(stream);
+}
+
+void rex_stream_close(rex_stream_t *stream) {
+    rex_reader_close(&stream->reader);
+    free(stream);
+}
+
+uint32_t rex_stream_layer_count(const rex_stream_t *stream) {
+    return stream->layer_count;
+}
+
+uint32_t rex_stream_width(const rex_stream_t *stream) {
+    return stream->width;
+}
+
+uint32_t rex_stream_height(const rex_stream_t *stream) {
+    return stream->height;
+}
+
+bool rex_stream_next_layer(rex_stream_t *stream) {
+    const char *name = stream->reader.name;
+    if (stream->tiles_remaining > 0) {
+        rex_set_error("%s: layer %d not fully read", name, stream->layer);
+        return false;
+    }
+    if (stream->layer + 1 >= (int32_t)stream->layer_count) {
+        rex_set_error("%s: no more layers", name);
+        return false;
+    }
+    stream->layer += 1;
+
+    // The first layer's header was read when the stream was opened
+    if (stream->layer > 0) {
+        uint32_t width, height;
+        if (!rex_read_fully(&stream->reader, &width, sizeof(width)) ||
+            !rex_read_fully(&stream->reader, &height, sizeof(height))) {
+            rex_set_error("%s: truncated header for layer %d", name, stream->layer);
+            return false;
+        }
+        if (width != stream->width || height != stream->height) {
+            rex_set_error("%s: layer %d is %ux%u but layer 0 is %ux%u", name, stream->layer,
+                    width, height, stream->width, stream->height);
+            return false;
+        }
+    }
+
+    stream->tiles_remaining = (uint64_t)stream->width * stream->height;
+    return true;
+}
+
+bool rex_stream_read_tiles(rex_stream_t *stream, rex_tile_t *tiles, uint64_t count) {
+    if (count > stream->tiles_remaining) {
+        rex_set_error("%s: read of %llu tiles runs past the end of layer %d", stream->reader.name,
+                (unsigned long long)count, stream->layer);
+        return false;
+    }
+    if (!rex_read_fully(&stream->reader, tiles, count * sizeof(rex_tile_t))) {
+        rex_set_error("%s: truncated tile data in layer %d", stream->reader.name, stream->layer);
+        return false;
+    }
+    stream->tiles_remaining -= count;
+    return true;
+}
+
+bool rex_stream_finish(rex_stream_t *stream) {
+    if (stream->layer + 1 != (int32_t)stream->layer_count || stream->tiles_remaining > 0) {
+        rex_set_error("%s: stream finished before all layers were read", stream->reader.name);
+        return false;
+    }
+
+    // Anything left over means the header doesn't describe this stream
+    uint8_t extra;
+    if (rex_reader_read(&stream->reader, &extra, 1) != 0) {
+        rex_set_error("%s: unexpected data after the last layer", stream->reader.name);
+        return false;
+    }
+    return true;
+}
+
+rex_index_t *rex_index_build(const char *filename, uint32_t span) {
+    // Validate the map's header before indexing it
+    rex_stream_t *stream = rex_stream_open(filename);
+    if (!stream) {
+        return NULL;
+    }
+
+    rex_index_t *index = calloc(1, sizeof(rex_index_t));
+    index->filename = strdup(filename);
+    rex_index_header_t *header = &index->header;
+    memcpy(header->magic, REX_INDEX_MAGIC, sizeof(header->magic));
+    header->version = REX_INDEX_VERSION;
+    header->byte_order = 0x01020304;
+    header->span = (span > 0) ? span : REX_INDEX_DEFAULT_SPAN;
+    header->map_version = stream->version;
+    header->layer_count = stream->layer_count;
+    header->width = stream->width;
+    header->height = stream->height;
+    rex_stream_close(stream);
+
+    FILE *file = fopen(filename, "rb");
+    if (!file || !rex_index_stat_source(file, &header->source_size, &header->source_mtime)) {
+        rex_set_error("%s: unable to open file", filename);
+        goto error;
+    }
+
+    uint8_t magic[2] = {0};
+    header->compressed = (fread(magic, 1, 2, file) == 2) && magic[0] == 0x1f && magic[1] == 0x8b;
+    if (header->compressed && !rex_index_add_checkpoints(index, file)) {
+        goto error;
+    }
+
+    fclose(file);
+    return index;
+
+error:
+    if (file) { fclose(file); }
+    rex_index_destroy(index);
+    return NULL;
+}
 
-    gzFile file = gzopen(filename, "r");
+bool rex_index_save(const rex_index_t *index, const char *index_filename) {
+    FILE *file = fopen(index_filename, "wb");
     if (!file) {
+        rex_set_error("%s: unable to create file", index_filename);
+        return false;
+    }
+
+    size_t checkpoint_count = index->header.checkpoint_count;
+    bool ok = (fwrite(&index->header, sizeof(rex_index_header_t), 1, file) == 1) &&
+              (fwrite(index->checkpoints, sizeof(rex_index_checkpoint_t), checkpoint_count, file) == checkpoint_count);
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        rex_set_error("%s: write failed", index_filename);
+        remove(index_filename);
+    }
+
+    return ok;
+}
+
+rex_index_t *rex_index_load(const char *index_filename, const char *filename) {
+    FILE *file = fopen(index_filename, "rb");
+    if (!file) {
+        rex_set_error("%s: unable to open file", index_filename);
         return NULL;
     }
 
-    // Read tile map information
-    rex_tile_map_t *tile_map = calloc(1, sizeof(rex_tile_map_t));
-    gzread(file, &tile_map->version, sizeof(tile_map->version));
-    gzread(file, &tile_map->layer_count, sizeof(tile_map->layer_count));
-    tile_map->layers = calloc(tile_map->layer_count, sizeof(rex_tile_layer_t));
+    rex_index_t *index = calloc(1, sizeof(rex_index_t));
+    index->filename = strdup(filename);
+    rex_index_header_t *header = &index->header;
+    if (fread(header, sizeof(rex_index_header_t), 1, file) != 1 ||
+        memcmp(header->magic, REX_INDEX_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != REX_INDEX_VERSION || header->byte_order != 0x01020304) {
+        rex_set_error("%s: not a REX index for this host", index_filename);
+        goto error;
+    }
 
-    // Read each layer
-    for (uint32_t i = 0; i < tile_map->layer_count; i++) {
-        rex_tile_layer_t *layer = calloc(1, sizeof(rex_tile_layer_t));
-        gzread(file, &layer->width, sizeof(layer->width));
-        gzread(file, &layer->height, sizeof(layer->height));
+    // The index describes the file as it was when indexed; any change invalidates it
+    uint64_t source_size;
+    int64_t source_mtime;
+    FILE *source = fopen(filename, "rb");
+    bool fresh = source && rex_index_stat_source(source, &source_size, &source_mtime) &&
+                 source_size == header->source_size && source_mtime == header->source_mtime;
+    if (source) { fclose(source); }
+    if (!fresh) {
+        rex_set_error("%s: index is out of date for %s", index_filename, filename);
+        goto error;
+    }
 
-        int32_t tile_count = layer->width * layer->height;
-        rex_tile_t *tiles = calloc(tile_count, sizeof(rex_tile_t));
-        for (int t = 0; t < tile_count; t++) {
-            gzread(file, &tiles[t], sizeof(rex_tile_t));
+    if (header->compressed && header->checkpoint_count == 0) {
+        rex_set_error("%s: index has no checkpoints", index_filename);
+        goto error;
+    }
+    index->checkpoints = malloc((size_t)header->checkpoint_count * sizeof(rex_index_checkpoint_t));
+    if ((header->checkpoint_count > 0 && !index->checkpoints) ||
+        fread(index->checkpoints, sizeof(rex_index_checkpoint_t), header->checkpoint_count, file) != header->checkpoint_count) {
+        rex_set_error("%s: truncated index", index_filename);
+        goto error;
+    }
+
+    // Regions seek and prime the inflater straight from the checkpoints, so they have to
+    // lie inside the file, in order, with the first at the start of the stream
+    for (uint32_t i = 0; i < header->checkpoint_count; i++) {
+        const rex_index_checkpoint_t *point = &index->checkpoints[i];
+        bool valid = point->bits <= 7 && point->in_offset <= source_size &&
+                     (point->bits == 0 || point->in_offset > 0) &&
+                     ((i == 0) ? point->out_offset == 0 : point->out_offset > index->checkpoints[i - 1].out_offset);
+        if (!valid) {
+            rex_set_error("%s: corrupt checkpoint %u", index_filename, i);
+            goto error;
         }
-        layer->tiles = tiles;
+    }
+
+    fclose(file);
+    return index;
+
+error:
+    fclose(file);
+    rex_index_destroy(index);
+    return NULL;
+}
+
+rex_index_t *rex_index_open(const char *filename) {
+    char *index_filename = malloc(strlen(filename) + sizeof(REX_INDEX_EXTENSION));
+    strcpy(index_filename, filename);
+    strcat(index_filename, REX_INDEX_EXTENSION);
+
+    rex_index_t *index = rex_index_load(index_filename, filename);
+    if (!index) {
+        index = rex_index_build(filename, 0);
+        // A read-only asset directory just means the index is rebuilt next time
+        if (index) { rex_index_save(index, index_filename); }
+    }
+
+    free(index_filename);
+    return index;
+}
+
+void rex_index_destroy(rex_index_t *index) {
+    free(index->checkpoints);
+    free(index->filename);
+    free(index);
+}
+
+uint32_t rex_index_layer_count(const rex_index_t *index) {
+    return index->header.layer_count;
+}
+
+uint32_t rex_index_width(const rex_index_t *index) {
+    return index->header.width;
+}
+
+uint32_t rex_index_height(const rex_index_t *index) {
+    return index->header.height;
+}
 
-        tile_map->layers[i] = *layer;
+rex_tile_layer_t *rex_load_region(const rex_index_t *index, uint32_t layer, uint32_t first_column, uint32_t column_count) {
+    const rex_index_header_t *header = &index->header;
+    if (layer >= header->layer_count || column_count == 0 ||
+        first_column >= header->width || column_count > header->width - first_column) {
+        rex_set_error("%s: region of layer %u, columns %u-%u is outside the %ux%u, %u layer map",
+                index->filename, layer, first_column, first_column + column_count, header->width,
+                header->height, header->layer_count);
+        return NULL;
     }
-    
-    // Store the width/height information at the map level for convenience
-    if (tile_map->layer_count > 0) {
-        tile_map->width = tile_map->layers[0].width;
-        tile_map->height = tile_map->layers[0].height;
+
+    // Whole columns are contiguous in the file, so the region is a single run of tiles
+    uint64_t layer_size = (uint64_t)header->width * header->height * sizeof(rex_tile_t);
+    uint64_t offset = REX_FILE_HEADER_SIZE + (uint64_t)layer * (REX_LAYER_HEADER_SIZE + layer_size) +
+                      REX_LAYER_HEADER_SIZE + (uint64_t)first_column * header->height * sizeof(rex_tile_t);
+    uint64_t tile_count = (uint64_t)column_count * header->height;
+
+    rex_tile_layer_t *region = calloc(1, sizeof(rex_tile_layer_t));
+    region->width = column_count;
+    region->height = header->height;
+    region->tiles = malloc(tile_count * sizeof(rex_tile_t));
+    if (!region->tiles || !rex_index_read(index, offset, region->tiles, tile_count * sizeof(rex_tile_t))) {
+        rex_destroy_tile_layer(region);
+        return NULL;
     }
-    
-    gzclose(file);
 
-    return tile_map;
+    return region;
 }
 
-void rex_destroy_tile_map(rex_tile_map_t *map) {
-    for (uint32_t l = 0; l < map->layer_count; l++) {
-        free(map->layers[l].tiles);
+void rex_destroy_tile_layer(rex_tile_layer_t *layer) {
+    free(layer->tiles);
+    free(layer);
+}
+
+bool rex_save_tile_map(const rex_tile_map_t *map, const char *filename, int level) {
+    char mode[8];
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) {
+        level = Z_DEFAULT_COMPRESSION;
     }
-    free(map->layers);
-    free(map);
+    if (level == Z_DEFAULT_COMPRESSION) {
+        snprintf(mode, sizeof(mode), "wb");
+    } else {
+        snprintf(mode, sizeof(mode), "wb%d", level);
+    }
+
+    gzFile file = gzopen(filename, mode);
+    if (!file) {
+        rex_set_error("%s: unable to create file", filename);
+        return false;
+    }
+    gzbuffer(file, REX_GZ_BUFFER_SIZE);
+
+    bool ok = rex_write_fully(file, &map->version, sizeof(map->version)) &&
+              rex_write_fully(file, &map->layer_count, sizeof(map->layer_count));
+    for (uint32_t l = 0; ok && l < map->layer_count; l++) {
+        const rex_tile_layer_t *layer = &map->layers[l];
+        ok = rex_write_fully(file, &layer->width, sizeof(layer->width)) &&
+             rex_write_fully(file, &layer->height, sizeof(layer->height)) &&
+             rex_write_fully(file, layer->tiles, (uint64_t)layer->width * layer->height * sizeof(rex_tile_t));
+    }
+
+    ok = (gzclose(file) == Z_OK) && ok;
+    if (!ok) {
+        rex_set_error("%s: write failed", filename);
+        remove(filename);
+    }
+
+    return ok;
 }
 
 rex_tile_layer_t *rex_flatten_tile_map(rex_tile_map_t *map) {
 
     uint32_t tile_count = map->width * map->height;
-    rex_tile_layer_t *working_layer = calloc(tile_count, sizeof(rex_tile_t));
+    rex_tile_layer_t *working_layer = calloc(1, sizeof(rex_tile_layer_t));
     working_layer->width = map->width;
     working_layer->height = map->height;
     working_layer->tiles = calloc(tile_count, sizeof(rex_tile_t));
@@ -70,20 +481,639 @@ rex_tile_layer_t *rex_flatten_tile_map(rex_tile_map_t *map) {
             if (!rex_tile_is_transparent(&layer->tiles[t])) {
                 working_layer->tiles[t] = layer->tiles[t];
             }
-        }        
+        }
     }
-    
+
     // TODO: Handle transparent tiles on the flattened tilemap?
 
     return working_layer;
 }
 
-bool rex_tile_is_transparent(rex_tile_t *tile) {
+bool rex_tile_is_transparent(const rex_tile_t *tile) {
     return (tile->bg_red == 255 && tile->bg_green == 0 && tile->bg_blue == 255);
 }
 
 
+// Internal Functions --
+
+static
+void rex_set_error(const char *format, ...) {
+    va_list argp;
+    va_start(argp, format);
+    vsnprintf(rex_error, sizeof(rex_error), format, argp);
+    va_end(argp);
+}
+
+static
+bool rex_reader_open_file(rex_reader_t *reader, const char *filename) {
+    memset(reader, 0, sizeof(rex_reader_t));
+    reader->source = REX_SOURCE_GZ_FILE;
+    reader->name = filename;
+
+    // The gzip trailer records the uncompressed size (mod 2^32), which lets us sanity check the
+    // header before trusting any of its dimensions for allocations
+    reader->have_stream_size = rex_read_stream_size(filename, &reader->stream_size);
+
+    reader->file = gzopen(filename, "rb");
+    if (!reader->file) {
+        rex_set_error("%s: unable to open file", filename);
+        return false;
+    }
+    gzbuffer(reader->file, REX_GZ_BUFFER_SIZE);
+
+    return true;
+}
+
+static
+bool rex_reader_open_memory(rex_reader_t *reader, const void *data, size_t size) {
+    memset(reader, 0, sizeof(rex_reader_t));
+    reader->name = "<memory>";
+    reader->data = data;
+    reader->remaining = size;
+
+    bool is_gzip = (size >= 18) && (reader->data[0] == 0x1f) && (reader->data[1] == 0x8b);
+    if (!is_gzip) {
+        reader->source = REX_SOURCE_RAW_MEMORY;
+        reader->have_stream_size = (size <= UINT32_MAX);
+        reader->stream_size = (uint32_t)size;
+        return true;
+    }
+
+    reader->source = REX_SOURCE_GZ_MEMORY;
+    const uint8_t *trailer = reader->data + size - 4;
+    reader->have_stream_size = true;
+    reader->stream_size = (uint32_t)trailer[0] | ((uint32_t)trailer[1] << 8) | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+
+    if (inflateInit2(&reader->inflater, 16 + MAX_WBITS) != Z_OK) {
+        rex_set_error("%s: unable to initialise inflater", reader->name);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Read up to length bytes. Returns the number of bytes read (0 at the end of the stream), or -1 on error.
+ */
+static
+int64_t rex_reader_read(rex_reader_t *reader, void *buffer, uint64_t length) {
+    unsigned chunk = (length > REX_READ_CHUNK_SIZE) ? REX_READ_CHUNK_SIZE : (unsigned)length;
+
+    switch (reader->source) {
+        case REX_SOURCE_GZ_FILE:
+            return gzread(reader->file, buffer, chunk);
+
+        case REX_SOURCE_RAW_MEMORY:
+            if (chunk > reader->remaining) { chunk = (unsigned)reader->remaining; }
+            memcpy(buffer, reader->data, chunk);
+            reader->data += chunk;
+            reader->remaining -= chunk;
+            return chunk;
+
+        case REX_SOURCE_GZ_MEMORY: {
+            z_stream *z = &reader->inflater;
+            z->next_out = buffer;
+            z->avail_out = chunk;
+            while (z->avail_out > 0) {
+                if (z->avail_in == 0 && reader->remaining > 0) {
+                    z->next_in = (Bytef *)reader->data;
+                    z->avail_in = (reader->remaining > REX_READ_CHUNK_SIZE) ? REX_READ_CHUNK_SIZE : (uInt)reader->remaining;
+                    reader->data += z->avail_in;
+                    reader->remaining -= z->avail_in;
+                }
+                int ret = inflate(z, Z_NO_FLUSH);
+                if (ret == Z_STREAM_END) { break; }
+                if (ret == Z_BUF_ERROR && z->avail_in == 0 && reader->remaining == 0) { break; }
+                if (ret != Z_OK) { return -1; }
+            }
+            return chunk - z->avail_out;
+        }
+    }
+
+    return -1;
+}
+
+static
+void rex_reader_close(rex_reader_t *reader) {
+    if (reader->source == REX_SOURCE_GZ_FILE && reader->file) {
+        gzclose(reader->file);
+    } else if (reader->source == REX_SOURCE_GZ_MEMORY) {
+        inflateEnd(&reader->inflater);
+    }
+}
+
+/*
+ * Read exactly length bytes from the stream. Returns false on a short read or a stream error.
+ */
+static
+bool rex_read_fully(rex_reader_t *reader, void *buffer, uint64_t length) {
+    uint8_t *dest = buffer;
+    while (length > 0) {
+        int64_t bytes_read = rex_reader_read(reader, dest, length);
+        if (bytes_read <= 0) {
+            return false;
+        }
+        dest += bytes_read;
+        length -= bytes_read;
+    }
+    return true;
+}
+
+/*
+ * Read and validate the file header and the first layer's header, so the map's dimensions
+ * are known as soon as the stream is open. Destroys the stream and returns NULL on failure.
+ */
+static
+rex_stream_t *rex_stream_start(rex_stream_t *stream) {
+    rex_reader_t *reader = &stream->reader;
+    const char *name = reader->name;
+    stream->layer = -1;
+
+    if (!rex_read_fully(reader, &stream->version, sizeof(stream->version)) ||
+        !rex_read_fully(reader, &stream->layer_count, sizeof(stream->layer_count))) {
+        rex_set_error("%s: truncated file header", name);
+        goto error;
+    }
+    if (stream->layer_count == 0 || stream->layer_count > REX_MAX_LAYERS) {
+        rex_set_error("%s: invalid layer count %u", name, stream->layer_count);
+        goto error;
+    }
+
+    if (!rex_read_fully(reader, &stream->width, sizeof(stream->width)) ||
+        !rex_read_fully(reader, &stream->height, sizeof(stream->height))) {
+        rex_set_error("%s: truncated header for layer 0", name);
+        goto error;
+    }
+    if (stream->width == 0 || stream->height == 0 ||
+        stream->width > REX_MAX_DIMENSION || stream->height > REX_MAX_DIMENSION) {
+        rex_set_error("%s: invalid dimensions %ux%u for layer 0", name, stream->width, stream->height);
+        goto error;
+    }
+
+    // Every layer has the same dimensions, so the whole stream size is known up front
+    if (reader->have_stream_size) {
+        uint64_t layer_size = (uint64_t)stream->width * stream->height * sizeof(rex_tile_t);
+        uint64_t total = REX_FILE_HEADER_SIZE + (uint64_t)stream->layer_count * (REX_LAYER_HEADER_SIZE + layer_size);
+        if ((uint32_t)total != reader->stream_size) {
+            rex_set_error("%s: header describes %llu bytes but the stream holds %u (mod 2^32)",
+                    name, (unsigned long long)total, reader->stream_size);
+            goto error;
+        }
+    }
+
+    return stream;
+
+error:
+    rex_stream_close(stream);
+    return NULL;
+}
+
+static
+rex_tile_map_t *rex_load_tile_map_from_stream(rex_stream_t *stream) {
+    rex_tile_map_t *tile_map = calloc(1, sizeof(rex_tile_map_t));
+    tile_map->version = stream->version;
+    tile_map->layer_count = stream->layer_count;
+    tile_map->width = stream->width;
+    tile_map->height = stream->height;
+    tile_map->layers = calloc(tile_map->layer_count, sizeof(rex_tile_layer_t));
+
+    uint64_t tile_count = (uint64_t)stream->width * stream->height;
+    for (uint32_t i = 0; i < tile_map->layer_count; i++) {
+        rex_tile_layer_t *layer = &tile_map->layers[i];
+        if (!rex_stream_next_layer(stream)) {
+            goto error;
+        }
+        layer->width = stream->width;
+        layer->height = stream->height;
+
+        layer->tiles = malloc(tile_count * sizeof(rex_tile_t));
+        if (layer->tiles == NULL) {
+            rex_set_error("%s: out of memory for layer %u", stream->reader.name, i);
+            goto error;
+        }
+
+        // Inflate the whole layer in as few reads as possible
+        if (!rex_stream_read_tiles(stream, layer->tiles, tile_count)) {
+            goto error;
+        }
+    }
+
+    if (!rex_stream_finish(stream)) {
+        goto error;
+    }
+
+    return tile_map;
+
+error:
+    rex_destroy_tile_map(tile_map);
+    return NULL;
+}
+
+/*
+ * Read the uncompressed size from the gzip trailer (the last four bytes, little-endian).
+ * Returns false if the file isn't gzip-compressed or can't be read.
+ */
+static
+bool rex_read_stream_size(const char *filename, uint32_t *size) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        return false;
+    }
+
+    uint8_t magic[2];
+    uint8_t trailer[4];
+    bool ok = (fread(magic, 1, 2, f) == 2) && magic[0] == 0x1f && magic[1] == 0x8b &&
+              (fseek(f, -4, SEEK_END) == 0) && (fread(trailer, 1, 4, f) == 4);
+    fclose(f);
+
+    if (ok) {
+        *size = (uint32_t)trailer[0] | ((uint32_t)trailer[1] << 8) | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+    }
+    return ok;
+}
+
+
+static
+bool rex_write_fully(gzFile file, const void *buffer, uint64_t length) {
+    const uint8_t *bytes = buffer;
+    while (length > 0) {
+        unsigned chunk = (length > REX_READ_CHUNK_SIZE) ? REX_READ_CHUNK_SIZE : (unsigned)length;
+        if (gzwrite(file, bytes, chunk) != (int)chunk) {
+            return false;
+        }
+        bytes += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+static
+bool rex_index_stat_source(FILE *file, uint64_t *size, int64_t *mtime) {
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0) {
+        return false;
+    }
+    *size = (uint64_t)st.st_size;
+    *mtime = (int64_t)st.st_mtime;
+    return true;
+}
+
+/*
+ * Inflate the whole file once, recording a checkpoint at the first deflate block boundary
+ * after every span bytes of output (and one at the very start).
+ * Based on the approach of zlib's examples/zran.c.
+ */
+static
+bool rex_index_add_checkpoints(rex_index_t *index, FILE *file) {
+    rex_index_header_t *header = &index->header;
+    uint8_t *input = malloc(REX_INDEX_INPUT_SIZE);
+    uint8_t *window = malloc(REX_INDEX_WINDOW_SIZE);
+    uint32_t capacity = 16;
+    index->checkpoints = malloc(capacity * sizeof(rex_index_checkpoint_t));
+
+    z_stream strm = {0};
+    int ret = inflateInit2(&strm, 16 + MAX_WBITS);
+    if (ret != Z_OK) {
+        rex_set_error("%s: unable to initialise inflater", index->filename);
+        goto done;
+    }
+    rewind(file);
+
+    // Output goes round the window buffer; only the last 32 KB is ever needed
+    uint64_t total_in = 0, total_out = 0, last = 0;
+    strm.avail_out = 0;
+    do {
+        if (strm.avail_in == 0) {
+            strm.avail_in = (uInt)fread(input, 1, REX_INDEX_INPUT_SIZE, file);
+            if (strm.avail_in == 0) {
+                ret = Z_DATA_ERROR;
+                break;
+            }
+            strm.next_in = input;
+        }
+        if (strm.avail_out == 0) {
+            strm.avail_out = REX_INDEX_WINDOW_SIZE;
+            strm.next_out = window;
+        }
+
+        total_in += strm.avail_in;
+        total_out += strm.avail_out;
+        ret = inflate(&strm, Z_BLOCK);
+        total_in -= strm.avail_in;
+        total_out -= strm.avail_out;
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            break;
+        }
+
+        // Bit 7 of data_type: stopped at a block boundary; bit 6: that block is the last one
+        bool at_boundary = (strm.data_type & 128) && !(strm.data_type & 64);
+        if (ret == Z_OK && at_boundary && (total_out == 0 || total_out - last > header->span)) {
+            if (header->checkpoint_count == capacity) {
+                capacity *= 2;
+                index->checkpoints = realloc(index->checkpoints, capacity * sizeof(rex_index_checkpoint_t));
+            }
+            rex_index_checkpoint_t *point = &index->checkpoints[header->checkpoint_count];
+            point->out_offset = total_out;
+            point->in_offset = total_in;
+            point->bits = (uint32_t)(strm.data_type & 7);
+            point->reserved = 0;
+
+            // Unwrap the window so the oldest byte comes first
+            uint32_t left = strm.avail_out;
+            if (left > 0) {
+                memcpy(point->window, window + REX_INDEX_WINDOW_SIZE - left, left);
+            }
+            if (left < REX_INDEX_WINDOW_SIZE) {
+                memcpy(point->window + left, window, REX_INDEX_WINDOW_SIZE - left);
+            }
+            header->checkpoint_count += 1;
+            last = total_out;
+        }
+    } while (ret != Z_STREAM_END);
+
+    uint64_t expected = REX_FILE_HEADER_SIZE + (uint64_t)header->layer_count *
+                        (REX_LAYER_HEADER_SIZE + (uint64_t)header->width * header->height * sizeof(rex_tile_t));
+    if (ret != Z_STREAM_END) {
+        rex_set_error("%s: corrupt or truncated gzip stream", index->filename);
+    } else if (total_out != expected) {
+        // e.g. a multi-member gzip file, which the checkpoints can't describe
+        rex_set_error("%s: inflated to %llu bytes but the header describes %llu", index->filename,
+                (unsigned long long)total_out, (unsigned long long)expected);
+        ret = Z_DATA_ERROR;
+    }
+    inflateEnd(&strm);
+
+done:
+    free(window);
+    free(input);
+    return (ret == Z_STREAM_END);
+}
+
+/*
+ * Read length bytes of the uncompressed stream, starting at offset, by inflating from the
+ * nearest checkpoint at or before it.
+ */
+static
+bool rex_index_read(const rex_index_t *index, uint64_t offset, void *buffer, uint64_t length) {
+    const rex_index_header_t *header = &index->header;
+    FILE *file = fopen(index->filename, "rb");
+    if (!file) {
+        rex_set_error("%s: unable to open file", index->filename);
+        return false;
+    }
+
+    if (!header->compressed) {
+        bool ok = (fseeko(file, (off_t)offset, SEEK_SET) == 0) && (fread(buffer, 1, length, file) == length);
+        fclose(file);
+        if (!ok) { rex_set_error("%s: truncated tile data", index->filename); }
+        return ok;
+    }
+
+    // Binary search for the last checkpoint at or before the offset; the first is at 0
+    uint32_t low = 0, high = header->checkpoint_count;
+    while (high - low > 1) {
+        uint32_t mid = low + (high - low) / 2;
+        if (index->checkpoints[mid].out_offset <= offset) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    const rex_index_checkpoint_t *point = &index->checkpoints[low];
+
+    uint8_t *input = malloc(REX_INDEX_INPUT_SIZE);
+    uint8_t *discard = malloc(REX_INDEX_WINDOW_SIZE);
+    z_stream strm = {0};
+    bool ok = false;
+    if (!input || !discard) {
+        rex_set_error("%s: out of memory", index->filename);
+        goto done;
+    }
+    if (inflateInit2(&strm, -MAX_WBITS) != Z_OK) {
+        rex_set_error("%s: unable to initialise inflater", index->filename);
+        goto done;
+    }
+
+    // Resume mid-stream: raw deflate from the boundary, primed with its partial byte and window
+    if (fseeko(file, (off_t)(point->in_offset - (point->bits ? 1 : 0)), SEEK_SET) != 0) {
+        goto corrupt;
+    }
+    if (point->bits) {
+        int byte = getc(file);
+        if (byte == EOF) {
+            goto corrupt;
+        }
+        inflatePrime(&strm, (int)point->bits, byte >> (8 - point->bits));
+    }
+    if (point->out_offset > 0) {
+        inflateSetDictionary(&strm, point->window, REX_INDEX_WINDOW_SIZE);
+    }
+
+    uint64_t skip = offset - point->out_offset;
+    uint8_t *out = buffer;
+    while (length > 0) {
+        if (strm.avail_in == 0) {
+            strm.avail_in = (uInt)fread(input, 1, REX_INDEX_INPUT_SIZE, file);
+            if (strm.avail_in == 0) {
+                goto corrupt;
+            }
+            strm.next_in = input;
+        }
+
+        // Inflate and throw away everything between the checkpoint and the offset
+        if (skip > 0) {
+            strm.next_out = discard;
+            strm.avail_out = (skip > REX_INDEX_WINDOW_SIZE) ? REX_INDEX_WINDOW_SIZE : (uInt)skip;
+        } else {
+            strm.next_out = out;
+            strm.avail_out = (length > REX_READ_CHUNK_SIZE) ? REX_READ_CHUNK_SIZE : (uInt)length;
+        }
+        uInt requested = strm.avail_out;
+
+        int ret = inflate(&strm, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            goto corrupt;
+        }
+
+        uInt produced = requested - strm.avail_out;
+        if (skip > 0) {
+            skip -= produced;
+        } else {
+            out += produced;
+            length -= produced;
+        }
+        if (ret == Z_STREAM_END && length > 0) {
+            goto corrupt;
+        }
+    }
+    ok = true;
+    goto done;
+
+corrupt:
+    rex_set_error("%s: corrupt data or stale index", index->filename);
+
+done:
+    inflateEnd(&strm);
+    free(discard);
+    free(input);
+    fclose(file);
+    return ok;
+}
+
 
+/* Test Harness - define __TEST__ to test */
 
+#ifdef __TEST__
+
+#include <string.h>
+#include <time.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+static void write_test_map(const char *filename, uint32_t width, uint32_t height, uint32_t layer_count, uint32_t claimed_layers) {
+    gzFile file = gzopen(filename, "wb6");
+    int32_t version = -1;
+    gzwrite(file, &version, sizeof(version));
+    gzwrite(file, &claimed_layers, sizeof(claimed_layers));
+    rex_tile_t *column = calloc(height, sizeof(rex_tile_t));
+    for (uint32_t l = 0; l < layer_count; l++) {
+        gzwrite(file, &width, sizeof(width));
+        gzwrite(file, &height, sizeof(height));
+        for (uint32_t x = 0; x < width; x++) {
+            for (uint32_t y = 0; y < height; y++) {
+                rex_tile_t tile = {(uint8_t)(x ^ y), 0, 0, 0, (uint8_t)x, (uint8_t)y, (uint8_t)l, 255, 0, (l % 2) ? 255 : 0};
+                column[y] = tile;
+            }
+            gzwrite(file, column, height * sizeof(rex_tile_t));
+        }
+    }
+    free(column);
+    gzclose(file);
+}
+
+// Save a copy of the index with one checkpoint field overwritten and try to load it
+static bool corrupt_checkpoint_rejected(const char *index_file, const char *world_file, uint32_t checkpoint,
+        size_t field_offset, const void *value, size_t value_size) {
+    const char *corrupt_file = "/tmp/rex_test_corrupt.xp.idx";
+    FILE *in = fopen(index_file, "rb");
+    FILE *out = fopen(corrupt_file, "wb");
+    int c;
+    while ((c = getc(in)) != EOF) { putc(c, out); }
+    fclose(in);
+
+    long offset = (long)(sizeof(rex_index_header_t) + (checkpoint * sizeof(rex_index_checkpoint_t)) + field_offset);
+    fseek(out, offset, SEEK_SET);
+    fwrite(value, value_size, 1, out);
+    fclose(out);
+
+    rex_index_t *index = rex_index_load(corrupt_file, world_file);
+    remove(corrupt_file);
+    if (index) {
+        rex_index_destroy(index);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    rex_tile_map_t *cat = rex_load_tile_map("assets/cat.xp");
+    printf("cat.xp: %s (%ux%u, %u layers)\n", cat ? "ok" : rex_get_error(),
+            cat ? cat->width : 0, cat ? cat->height : 0, cat ? cat->layer_count : 0);
+    if (cat) { rex_destroy_tile_map(cat); }
+
+    // Malformed files must be rejected with an error rather than loaded
+    write_test_map("/tmp/rex_test_layers.xp", 16, 8, 2, 3);
+    rex_tile_map_t *bad = rex_load_tile_map("/tmp/rex_test_layers.xp");
+    printf("Claimed layer count mismatch rejected: %s (%s)\n", bad ? "NO" : "yes", rex_get_error());
+    if (bad) { rex_destroy_tile_map(bad); }
+
+    // Throughput benchmark
+    const char *bench_file = (argc > 1) ? argv[1] : "/tmp/rex_bench.xp";
+    if (argc <= 1) {
+        write_test_map(bench_file, 1024, 1024, 4, 4);
+    }
+    uint32_t iterations = 10;
+    uint64_t bytes = 0;
+    double start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        rex_tile_map_t *map = rex_load_tile_map(bench_file);
+        if (!map) {
+            printf("Benchmark load failed: %s\n", rex_get_error());
+            return 1;
+        }
+        bytes += REX_FILE_HEADER_SIZE + (uint64_t)map->layer_count * (REX_LAYER_HEADER_SIZE + (uint64_t)map->width * map->height * sizeof(rex_tile_t));
+        rex_destroy_tile_map(map);
+    }
+    double elapsed = now_seconds() - start;
+    printf("Loaded %s %u times: %.1f MB/s uncompressed (%.2f ms per load)\n",
+            bench_file, iterations, (bytes / (1024.0 * 1024.0)) / elapsed, (elapsed * 1000.0) / iterations);
+
+    // Regional decoding: regions must match the full load, and cost far less than it
+    const char *world_file = "/tmp/rex_test_world.xp";
+    write_test_map(world_file, 4000, 500, 2, 2);
+    start = now_seconds();
+    rex_index_t *index = rex_index_build(world_file, 0);
+    if (!index) {
+        printf("Index build failed: %s\n", rex_get_error());
+        return 1;
+    }
+    printf("Indexed %s in %.2f ms\n", world_file, (now_seconds() - start) * 1000.0);
+
+    start = now_seconds();
+    rex_tile_map_t *world = rex_load_tile_map(world_file);
+    double full_time = now_seconds() - start;
+
+    bool regions_match = true;
+    uint32_t region_columns[][3] = { {0, 0, 100}, {1, 1950, 100}, {1, 3900, 100}, {0, 3999, 1} };
+    start = now_seconds();
+    for (uint32_t i = 0; i < 4; i++) {
+        uint32_t l = region_columns[i][0], x = region_columns[i][1], count = region_columns[i][2];
+        rex_tile_layer_t *region = rex_load_region(index, l, x, count);
+        const rex_tile_t *expected = &world->layers[l].tiles[(size_t)x * world->height];
+        if (!region || memcmp(region->tiles, expected, (size_t)count * world->height * sizeof(rex_tile_t)) != 0) {
+            regions_match = false;
+        }
+        if (region) { rex_destroy_tile_layer(region); }
+    }
+    double region_time = (now_seconds() - start) / 4;
+    printf("Regions match full load: %s (%.2f ms per 100 column region, %.2f ms full load)\n",
+            regions_match ? "yes" : "NO", region_time * 1000.0, full_time * 1000.0);
+    rex_destroy_tile_map(world);
+
+    rex_tile_layer_t *outside = rex_load_region(index, 0, 3950, 100);
+    printf("Region past the edge rejected: %s\n", outside ? "NO" : "yes");
+
+    const char *index_file = "/tmp/rex_test_world.xp.idx";
+    rex_index_save(index, index_file);
+    rex_index_destroy(index);
+    index = rex_index_load(index_file, world_file);
+    printf("Saved index reloads: %s\n", index ? "yes" : rex_get_error());
+    uint32_t checkpoint_count = index ? index->header.checkpoint_count : 0;
+    if (index) { rex_index_destroy(index); }
+
+    // Damaged checkpoints in the sidecar must be caught on load, not when a region is read
+    uint32_t bad_bits = 8;
+    uint64_t bad_out_offset = 0;
+    bool bad_bits_rejected = corrupt_checkpoint_rejected(index_file, world_file, 0,
+            offsetof(rex_index_checkpoint_t, bits), &bad_bits, sizeof(bad_bits));
+    bool bad_order_rejected = checkpoint_count > 1 && corrupt_checkpoint_rejected(index_file, world_file, 1,
+            offsetof(rex_index_checkpoint_t, out_offset), &bad_out_offset, sizeof(bad_out_offset));
+    printf("Corrupt checkpoints rejected: bits %s, out of order %s\n",
+            bad_bits_rejected ? "yes" : "NO", bad_order_rejected ? "yes" : "NO");
+
+    write_test_map(world_file, 4000, 400, 2, 2);
+    index = rex_index_load(index_file, world_file);
+    printf("Stale index rejected: %s\n", index ? "NO" : "yes");
+    if (index) { rex_index_destroy(index); }
+    remove(index_file);
+    remove(world_file);
+
+    return (bad_bits_rejected && bad_order_rejected) ? 0 : 1;
+}
 
+#endif
 
@@ -2,9 +2,16 @@
 #define REX_LOADER_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 
+#define REX_MAX_LAYERS          32
+#define REX_MAX_DIMENSION       32768
+
+#define REX_FILE_HEADER_SIZE    8   // version + layer count
+#define REX_LAYER_HEADER_SIZE   8   // width + height
+
 typedef struct {
     uint8_t char_code;
     uint8_t unused_1;
@@ -32,11 +39,139 @@ typedef struct {
     rex_tile_layer_t *layers;
 } rex_tile_map_t;
 
+/*
+ * Load a REXPaint .xp file. Each layer is inflated with a few large reads straight into its tile array.
+ * The header is validated against the stream (layer count, per-layer dimensions, total size);
+ * on failure NULL is returned and rex_get_error() describes the problem.
+ * Multi-byte fields are read as stored (little-endian).
+ */
 rex_tile_map_t *rex_load_tile_map(const char *filename);
+
+/*
+ * Load a REXPaint map from data already in memory, e.g. an entry in an asset archive.
+ * The data may be gzip-compressed (as in a .xp file) or raw.
+ */
+rex_tile_map_t *rex_load_tile_map_from_memory(const void *data, size_t size);
 void rex_destroy_tile_map(rex_tile_map_t *map);
 
+/*
+ * Write a map as a gzip-compressed REXPaint .xp file at the given zlib level
+ * (0-9, or -1 for zlib's default). Tiles are written as stored, column-major.
+ */
+bool rex_save_tile_map(const rex_tile_map_t *map, const char *filename, int level);
+
+/*
+ * Description of the last failure on the calling thread.
+ */
+const char *rex_get_error(void);
+
+
+/*
+ * Streaming access - read a REX file a layer at a time, in chunks of the caller's choosing,
+ * without holding the whole map in memory. Each layer's tiles arrive in file order
+ * (column-major). Errors are reported through rex_get_error().
+ *
+ *  Example usage:
+ *      rex_stream_t *stream = rex_stream_open(filename);
+ *      while (rex_stream_next_layer(stream)) {
+ *          // call rex_stream_read_tiles() until the layer's width * height tiles are read
+ *      }
+ *      rex_stream_finish(stream);     // checks nothing follows the last layer
+ *      rex_stream_close(stream);
+ */
+
+typedef struct rex_stream_s rex_stream_t;
+
+/*
+ * Open a stream and validate its header (layer count, dimensions, total size).
+ * Returns NULL on failure.
+ */
+rex_stream_t *rex_stream_open(const char *filename);
+rex_stream_t *rex_stream_open_memory(const void *data, size_t size);
+void rex_stream_close(rex_stream_t *stream);
+
+uint32_t rex_stream_layer_count(const rex_stream_t *stream);
+uint32_t rex_stream_width(const rex_stream_t *stream);
+uint32_t rex_stream_height(const rex_stream_t *stream);
+
+/*
+ * Advance to the next layer. Returns false when there are no more layers, or on error.
+ * The previous layer must have been read completely.
+ */
+bool rex_stream_next_layer(rex_stream_t *stream);
+
+/*
+ * Read exactly count tiles from the current layer. Returns false on error or if the layer
+ * has fewer tiles left.
+ */
+bool rex_stream_read_tiles(rex_stream_t *stream, rex_tile_t *tiles, uint64_t count);
+
+/*
+ * Check the stream ended exactly after the last layer.
+ */
+bool rex_stream_finish(rex_stream_t *stream);
+
+
+/*
+ * Region index - random access into large compressed maps.
+ *
+ * gzip can only be decoded from the start, so reading a region near the end of a big map
+ * would mean inflating everything before it. An index records inflater checkpoints (the
+ * stream position plus the preceding 32 KB of output) roughly every span bytes through the
+ * file, so a region is decoded starting from the nearest checkpoint instead: the cost is
+ * the region's size plus at most one span, however large the file.
+ *
+ * REX layers are stored column-major, so a region is a run of whole columns of one layer.
+ * An index is kept next to the map as a sidecar file ("map.xp.idx"); it records the map's
+ * size and modification time and is rejected once the map changes.
+ *
+ *  Example usage:
+ *      rex_index_t *index = rex_index_open("world.xp");      // loads or builds world.xp.idx
+ *      rex_tile_layer_t *region = rex_load_region(index, 0, player_x - 50, 100);
+ *      ...
+ *      rex_destroy_tile_layer(region);
+ *      rex_index_destroy(index);
+ */
+
+#define REX_INDEX_EXTENSION     ".idx"
+#define REX_INDEX_DEFAULT_SPAN  (256 * 1024)    // uncompressed bytes between checkpoints
+
+typedef struct rex_index_s rex_index_t;
+
+/*
+ * Index the given map by inflating it once. A span of 0 uses REX_INDEX_DEFAULT_SPAN;
+ * each checkpoint takes 32 KB, so smaller spans trade index size for faster regions.
+ * Uncompressed maps need no checkpoints. Returns NULL on failure.
+ */
+rex_index_t *rex_index_build(const char *filename, uint32_t span);
+bool rex_index_save(const rex_index_t *index, const char *index_filename);
+
+/*
+ * Load an index for the given map. Returns NULL if it can't be read or the map has
+ * changed since it was built.
+ */
+rex_index_t *rex_index_load(const char *index_filename, const char *filename);
+
+/*
+ * Load the map's sidecar index, building (and trying to save) it if it's missing or stale.
+ */
+rex_index_t *rex_index_open(const char *filename);
+void rex_index_destroy(rex_index_t *index);
+
+uint32_t rex_index_layer_count(const rex_index_t *index);
+uint32_t rex_index_width(const rex_index_t *index);
+uint32_t rex_index_height(const rex_index_t *index);
+
+/*
+ * Decode columns [first_column, first_column + column_count) of one layer of the indexed map.
+ * The returned layer is column_count wide and the full map height; free it with
+ * rex_destroy_tile_layer. Returns NULL on failure.
+ */
+rex_tile_layer_t *rex_load_region(const rex_index_t *index, uint32_t layer, uint32_t first_column, uint32_t column_count);
+void rex_destroy_tile_layer(rex_tile_layer_t *layer);
+
 rex_tile_layer_t *rex_flatten_tile_map(rex_tile_map_t *map);
-bool rex_tile_is_transparent(rex_tile_t *tile);
+bool rex_tile_is_transparent(const rex_tile_t *tile);
 
 #endif
 
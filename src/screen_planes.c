@@ -0,0 +1,273 @@
+
+
+#include "screen_planes.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Internal Functions --
+
+static bool screen_planes_buffers_create(uint32_t width, uint32_t plane_mask, bool lazy,
+        uint8_t **scratch, console_cell_t **row);
+static void screen_planes_export_into(const console_screen_t *screen, uint32_t plane_mask,
+        uint8_t *buffer, size_t plane_stride, size_t row_stride, uint8_t *scratch, console_cell_t *row);
+static void screen_planes_export_row(const console_cell_t *cells, uint32_t width, uint8_t *const *planes);
+
+
+// External Interface --
+
+uint32_t screen_planes_count(uint32_t plane_mask) {
+    return (uint32_t)__builtin_popcount(plane_mask & SCREEN_PLANES_ALL);
+}
+
+bool screen_planes_export(const console_screen_t *screen, uint32_t plane_mask,
+        uint8_t *buffer, size_t plane_stride, size_t row_stride) {
+
+    uint8_t *scratch;
+    console_cell_t *row;
+    if (!screen_planes_buffers_create(screen->width, plane_mask, screen->row_generations != NULL, &scratch, &row)) {
+        return false;
+    }
+
+    screen_planes_export_into(screen, plane_mask, buffer, plane_stride, row_stride, scratch, row);
+
+    free(row);
+    free(scratch);
+    return true;
+}
+
+bool screen_planes_export_batch(const console_screen_t *const *screens, uint32_t screen_count, uint32_t plane_mask,
+        uint8_t *buffer, size_t screen_stride, size_t plane_stride, size_t row_stride) {
+
+    // One set of buffers, big enough for the widest screen, shared by the whole batch
+    uint32_t max_width = 0;
+    bool any_lazy = false;
+    for (uint32_t i = 0; i < screen_count; i++) {
+        if (screens[i]->width > max_width) {
+            max_width = screens[i]->width;
+        }
+        any_lazy = any_lazy || screens[i]->row_generations != NULL;
+    }
+
+    uint8_t *scratch;
+    console_cell_t *row;
+    if (!screen_planes_buffers_create(max_width, plane_mask, any_lazy, &scratch, &row)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < screen_count; i++) {
+        screen_planes_export_into(screens[i], plane_mask, buffer + (i * screen_stride), plane_stride, row_stride,
+                scratch, row);
+    }
+
+    free(row);
+    free(scratch);
+    return true;
+}
+
+
+// Internal Functions --
+
+/*
+ * Allocate the working buffers for exporting screens up to width cells wide: a scratch row
+ * per plane when not all planes are selected, and a row of cells when a screen is lazily
+ * cleared. Either is left NULL when it isn't needed.
+ */
+static
+bool screen_planes_buffers_create(uint32_t width, uint32_t plane_mask, bool lazy,
+        uint8_t **scratch, console_cell_t **row) {
+
+    *scratch = NULL;
+    *row = NULL;
+    if ((plane_mask & SCREEN_PLANES_ALL) != SCREEN_PLANES_ALL) {
+        *scratch = malloc((size_t)width * SCREEN_PLANE_COUNT);
+        if (*scratch == NULL) {
+            return false;
+        }
+    }
+    if (lazy) {
+        *row = malloc(width * sizeof(console_cell_t));
+        if (*row == NULL) {
+            free(*scratch);
+            *scratch = NULL;
+            return false;
+        }
+    }
+    return true;
+}
+
+static
+void screen_planes_export_into(const console_screen_t *screen, uint32_t plane_mask,
+        uint8_t *buffer, size_t plane_stride, size_t row_stride, uint8_t *scratch, console_cell_t *row) {
+
+    // Planes that weren't asked for still get written, each to its own scratch row, so the
+    // per-cell loop has no branches
+    uint8_t *planes[SCREEN_PLANE_COUNT];
+    bool selected[SCREEN_PLANE_COUNT];
+    uint32_t next = 0;
+    for (uint32_t p = 0; p < SCREEN_PLANE_COUNT; p++) {
+        selected[p] = (plane_mask & (1u << p)) != 0;
+        if (selected[p]) {
+            planes[p] = buffer + (next * plane_stride);
+            next += 1;
+        } else {
+            planes[p] = scratch + ((size_t)p * screen->width);
+        }
+    }
+
+    // Lazily cleared screens may hold stale rows, which have to be read as cleared
+    bool lazy = screen->row_generations != NULL;
+
+    for (uint32_t y = 0; y < screen->height; y++) {
+        const console_cell_t *cells = &screen->cells[y * screen->width];
+        if (lazy) {
+            console_screen_copy_rows(screen, y, 1, row);
+            cells = row;
+        }
+        screen_planes_export_row(cells, screen->width, planes);
+        for (uint32_t p = 0; p < SCREEN_PLANE_COUNT; p++) {
+            if (selected[p]) {
+                planes[p] += row_stride;
+            }
+        }
+    }
+}
+
+static
+void screen_planes_export_row(const console_cell_t *cells, uint32_t width, uint8_t *const *planes) {
+    uint8_t *restrict glyph = planes[0];
+    uint8_t *restrict fg_red = planes[1];
+    uint8_t *restrict fg_green = planes[2];
+    uint8_t *restrict fg_blue = planes[3];
+    uint8_t *restrict bg_red = planes[4];
+    uint8_t *restrict bg_green = planes[5];
+    uint8_t *restrict bg_blue = planes[6];
+
+    for (uint32_t x = 0; x < width; x++) {
+        uint32_t fg = cells[x].fg_color;
+        uint32_t bg = cells[x].bg_color;
+        glyph[x] = (uint8_t)cells[x].glyph;
+        fg_red[x] = (uint8_t)RED(fg);
+        fg_green[x] = (uint8_t)GREEN(fg);
+        fg_blue[x] = (uint8_t)BLUE(fg);
+        bg_red[x] = (uint8_t)RED(bg);
+        bg_green[x] = (uint8_t)GREEN(bg);
+        bg_blue[x] = (uint8_t)BLUE(bg);
+    }
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#include <time.h>
+
+#define TEST_SCREENS    256
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1e6);
+}
+
+// The cell-by-cell copy this replaces
+static void export_by_cell(console_screen_t *screen, uint8_t *buffer) {
+    size_t plane = (size_t)screen->width * screen->height;
+    for (uint32_t y = 0; y < screen->height; y++) {
+        for (uint32_t x = 0; x < screen->width; x++) {
+            console_cell_t *cell = console_screen_cell(screen, x, y);
+            size_t i = (y * screen->width) + x;
+            buffer[i] = (uint8_t)cell->glyph;
+            buffer[plane + i] = RED(cell->fg_color);
+            buffer[(2 * plane) + i] = GREEN(cell->fg_color);
+            buffer[(3 * plane) + i] = BLUE(cell->fg_color);
+            buffer[(4 * plane) + i] = RED(cell->bg_color);
+            buffer[(5 * plane) + i] = GREEN(cell->bg_color);
+            buffer[(6 * plane) + i] = BLUE(cell->bg_color);
+        }
+    }
+}
+
+int main() {
+    uint32_t width = 80;
+    uint32_t height = 25;
+    console_screen_t *screens[TEST_SCREENS];
+    uint32_t seed = 1;
+    for (uint32_t s = 0; s < TEST_SCREENS; s++) {
+        screens[s] = console_screen_create(width, height, 0);
+        for (uint32_t i = 0; i < width * height; i++) {
+            seed = (seed * 1103515245) + 12345;
+            screens[s]->cells[i] = (console_cell_t){ seed >> 24, seed, seed * 31 };
+        }
+    }
+
+    size_t plane = (size_t)width * height;
+    size_t screen_size = plane * SCREEN_PLANE_COUNT;
+    uint8_t *tensor = malloc(screen_size * TEST_SCREENS);
+    uint8_t *expected = malloc(screen_size * TEST_SCREENS);
+    memset(tensor, 0, screen_size * TEST_SCREENS);
+    memset(expected, 0, screen_size * TEST_SCREENS);
+
+    double start = now_ms();
+    for (uint32_t s = 0; s < TEST_SCREENS; s++) {
+        export_by_cell(screens[s], expected + (s * screen_size));
+    }
+    double by_cell_ms = now_ms() - start;
+
+    start = now_ms();
+    screen_planes_export_batch((const console_screen_t *const *)screens, TEST_SCREENS, SCREEN_PLANES_ALL,
+            tensor, screen_size, plane, width);
+    double batch_ms = now_ms() - start;
+
+    bool match = memcmp(tensor, expected, screen_size * TEST_SCREENS) == 0;
+    printf("%u screens: cell by cell %.2f ms, batch export %.2f ms, match: %s\n",
+            TEST_SCREENS, by_cell_ms, batch_ms, match ? "yes" : "NO");
+
+    // Just glyphs and background blue, into a padded layout
+    size_t row_stride = width + 16;
+    uint8_t *padded = calloc(2 * row_stride * height, 1);
+    screen_planes_export(screens[0], SCREEN_PLANE_GLYPH | SCREEN_PLANE_BG_BLUE, padded, row_stride * height, row_stride);
+    bool subset = true;
+    for (uint32_t y = 0; y < height; y++) {
+        subset = subset &&
+            memcmp(&padded[y * row_stride], &expected[y * width], width) == 0 &&
+            memcmp(&padded[(row_stride * height) + (y * row_stride)], &expected[(6 * plane) + (y * width)], width) == 0 &&
+            padded[(y * row_stride) + width] == 0;
+    }
+    printf("Selected planes with padded rows: %s (%u planes)\n", subset ? "yes" : "NO",
+            screen_planes_count(SCREEN_PLANE_GLYPH | SCREEN_PLANE_BG_BLUE));
+
+    // A lazily cleared screen in a batch reads as cleared: glyph 0 on its background
+    console_screen_t *lazy = console_screen_create(width / 2, height, 0x000000c0);
+    console_screen_set_lazy_clear(lazy, true);
+    console_screen_clear(lazy);
+    console_screen_set_cell(lazy, 1, 1, (console_cell_t){ 'x', 0xffffffff, 0x000000c0 });
+    const console_screen_t *mixed[2] = { screens[0], lazy };
+    memset(padded, 0xff, 2 * row_stride * height);
+    bool exported = screen_planes_export_batch(mixed, 2, SCREEN_PLANE_GLYPH, padded, row_stride * height,
+            row_stride * height, row_stride);
+    bool lazy_ok = exported;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < lazy->width; x++) {
+            uint8_t glyph = padded[(row_stride * height) + (y * row_stride) + x];
+            lazy_ok = lazy_ok && glyph == ((x == 1 && y == 1) ? 'x' : 0);
+        }
+    }
+    printf("Lazily cleared screen in a batch: %s\n", lazy_ok ? "yes" : "NO");
+    console_screen_destroy(lazy);
+
+    free(padded);
+    free(expected);
+    free(tensor);
+    for (uint32_t s = 0; s < TEST_SCREENS; s++) {
+        console_screen_destroy(screens[s]);
+    }
+
+    return (match && subset && lazy_ok) ? 0 : 1;
+}
+
+#endif
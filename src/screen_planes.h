@@ -0,0 +1,70 @@
+#ifndef SCREEN_PLANES_H
+#define SCREEN_PLANES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "console.h"
+
+
+/*
+ * Screen planes - screens as dense uint8 tensors, e.g. as observations for a model.
+ *
+ * A screen exports as [planes, height, width] bytes: the glyph plane, then the red,
+ * green and blue planes of the foreground and background colors, keeping only the planes
+ * selected by a mask, in that order. The layout is set by the caller's strides, so screens
+ * can be written straight into a pre-allocated (possibly padded) batch tensor. Each screen
+ * is read in a single pass.
+ *
+ * Screen cells are stored interleaved (glyph, fg, bg per cell), so there are no planes
+ * that could be handed out without copying.
+ *
+ *  Example usage:
+ *      // [batch, 7, height, width], densely packed
+ *      size_t row = width, plane = row * height, screen = plane * 7;
+ *      screen_planes_export_batch(screens, batch, SCREEN_PLANES_ALL, tensor, screen, plane, row);
+ */
+
+
+/** Type definitions **/
+
+typedef enum {
+    SCREEN_PLANE_GLYPH  = 1 << 0,   // low 8 bits of the glyph code
+    SCREEN_PLANE_FG_RED = 1 << 1,
+    SCREEN_PLANE_FG_GREEN = 1 << 2,
+    SCREEN_PLANE_FG_BLUE = 1 << 3,
+    SCREEN_PLANE_BG_RED = 1 << 4,
+    SCREEN_PLANE_BG_GREEN = 1 << 5,
+    SCREEN_PLANE_BG_BLUE = 1 << 6
+} screen_plane_t;
+
+#define SCREEN_PLANE_COUNT  7
+#define SCREEN_PLANES_ALL   0x7f
+
+
+/** Public Interface **/
+
+/**
+ *  The number of planes selected by the mask.
+ */
+uint32_t screen_planes_count(uint32_t plane_mask);
+
+/**
+ *  Write the selected planes of the screen into buffer. Plane p, row y, column x goes to
+ *  buffer[(p * plane_stride) + (y * row_stride) + x], counting p over selected planes only.
+ *  Returns false, writing nothing, if the working buffers can't be allocated.
+ */
+bool screen_planes_export(const console_screen_t *screen, uint32_t plane_mask,
+        uint8_t *buffer, size_t plane_stride, size_t row_stride);
+
+/**
+ *  Export each screen in turn, screen i starting at buffer + (i * screen_stride). Screens
+ *  may differ in size as long as the strides leave room for the largest. Working buffers
+ *  are allocated once for the whole batch; returns false, writing nothing, if they can't be.
+ */
+bool screen_planes_export_batch(const console_screen_t *const *screens, uint32_t screen_count, uint32_t plane_mask,
+        uint8_t *buffer, size_t screen_stride, size_t plane_stride, size_t row_stride);
+
+
+#endif
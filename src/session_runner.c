@@ -0,0 +1,315 @@
+
+
+#ifdef __linux__
+#define _GNU_SOURCE     // pthread_setaffinity_np, sched_getaffinity
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "session_runner.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Internal Functions --
+
+static int session_runner_worker(void *data);
+static void session_runner_pin_worker(runner_worker_t *worker);
+static void session_runner_barrier_wait(session_runner_t *runner);
+static double runner_seconds(void);
+
+
+// External Interface --
+
+session_runner_t * session_runner_create(uint32_t session_count, uint32_t width, uint32_t height,
+        uint32_t thread_count, runner_step_fn step, void *context) {
+
+    if (session_count == 0) {
+        return NULL;
+    }
+    if (thread_count == 0) {
+        int cpus = SDL_GetCPUCount();
+        thread_count = (cpus > 0) ? (uint32_t)cpus : 1;
+    }
+    if (thread_count > session_count) {
+        thread_count = session_count;
+    }
+
+    session_runner_t *runner = calloc(1, sizeof(session_runner_t));
+    runner->session_count = session_count;
+    runner->sessions = calloc(session_count, sizeof(runner_session_t));
+    runner->step = step;
+    runner->context = context;
+    for (uint32_t i = 0; i < session_count; i++) {
+        runner->sessions[i].index = i;
+        runner->sessions[i].screen = console_screen_create(width, height, 0);
+    }
+
+    runner->lock = SDL_CreateMutex();
+    runner->start = SDL_CreateCond();
+    runner->finish = SDL_CreateCond();
+    runner->barrier = SDL_CreateCond();
+    runner->running = true;
+
+    // Contiguous blocks, so neighbouring sessions share a worker and its cache
+    runner->worker_count = thread_count;
+    runner->workers = calloc(thread_count, sizeof(runner_worker_t));
+    for (uint32_t t = 0; t < thread_count; t++) {
+        runner_worker_t *worker = &runner->workers[t];
+        worker->runner = runner;
+        worker->index = t;
+        worker->first_session = (uint32_t)(((uint64_t)session_count * t) / thread_count);
+        worker->session_count = (uint32_t)(((uint64_t)session_count * (t + 1)) / thread_count) - worker->first_session;
+        worker->thread = SDL_CreateThread(session_runner_worker, "session_runner", worker);
+        if (worker->thread == NULL) {
+            // Stop the workers that did start, then tear everything down
+            runner->worker_count = t;
+            session_runner_destroy(runner);
+            return NULL;
+        }
+    }
+
+    return runner;
+}
+
+void session_runner_destroy(session_runner_t *runner) {
+    SDL_LockMutex(runner->lock);
+    runner->running = false;
+    runner->run_generation += 1;
+    SDL_CondBroadcast(runner->start);
+    SDL_UnlockMutex(runner->lock);
+
+    for (uint32_t t = 0; t < runner->worker_count; t++) {
+        SDL_WaitThread(runner->workers[t].thread, NULL);
+    }
+
+    for (uint32_t i = 0; i < runner->session_count; i++) {
+        console_screen_destroy(runner->sessions[i].screen);
+    }
+    SDL_DestroyCond(runner->barrier);
+    SDL_DestroyCond(runner->finish);
+    SDL_DestroyCond(runner->start);
+    SDL_DestroyMutex(runner->lock);
+    free(runner->workers);
+    free(runner->sessions);
+    free(runner);
+}
+
+runner_session_t * session_runner_session(session_runner_t *runner, uint32_t index) {
+    if (index >= runner->session_count) {
+        return NULL;
+    }
+    return &runner->sessions[index];
+}
+
+void session_runner_run(session_runner_t *runner, runner_mode_t mode, uint64_t frame_count) {
+    double start = runner_seconds();
+
+    SDL_LockMutex(runner->lock);
+    runner->mode = mode;
+    runner->frame_count = frame_count;
+    runner->finished = 0;
+    runner->run_generation += 1;
+    SDL_CondBroadcast(runner->start);
+    while (runner->finished < runner->worker_count) {
+        SDL_CondWait(runner->finish, runner->lock);
+    }
+    SDL_UnlockMutex(runner->lock);
+
+    runner_stats_t *stats = &runner->stats;
+    stats->frames += frame_count * runner->session_count;
+    stats->seconds += runner_seconds() - start;
+    stats->frames_per_second = (stats->seconds > 0) ? stats->frames / stats->seconds : 0;
+}
+
+runner_stats_t session_runner_stats(const session_runner_t *runner) {
+    return runner->stats;
+}
+
+
+// Internal Functions --
+
+static
+int session_runner_worker(void *data) {
+    runner_worker_t *worker = data;
+    session_runner_t *runner = worker->runner;
+    runner_session_t *sessions = &runner->sessions[worker->first_session];
+    session_runner_pin_worker(worker);
+
+    uint32_t seen_generation = 0;
+    while (1) {
+        SDL_LockMutex(runner->lock);
+        while (runner->run_generation == seen_generation) {
+            SDL_CondWait(runner->start, runner->lock);
+        }
+        seen_generation = runner->run_generation;
+        bool running = runner->running;
+        runner_mode_t mode = runner->mode;
+        uint64_t frame_count = runner->frame_count;
+        SDL_UnlockMutex(runner->lock);
+
+        if (!running) {
+            break;
+        }
+
+        if (mode == SESSION_RUNNER_LOCKSTEP) {
+            for (uint64_t f = 0; f < frame_count; f++) {
+                for (uint32_t i = 0; i < worker->session_count; i++) {
+                    runner->step(&sessions[i], runner->context);
+                    sessions[i].frame += 1;
+                }
+                session_runner_barrier_wait(runner);
+            }
+        } else {
+            for (uint32_t i = 0; i < worker->session_count; i++) {
+                for (uint64_t f = 0; f < frame_count; f++) {
+                    runner->step(&sessions[i], runner->context);
+                    sessions[i].frame += 1;
+                }
+            }
+        }
+
+        SDL_LockMutex(runner->lock);
+        runner->finished += 1;
+        SDL_CondSignal(runner->finish);
+        SDL_UnlockMutex(runner->lock);
+    }
+
+    return 0;
+}
+
+/*
+ * Keep each worker on one core, so its sessions stay warm in that core's cache. Workers
+ * are spread over the cores the process may run on, which under taskset or a container's
+ * cpuset needn't be cores 0 to N - 1.
+ */
+static
+void session_runner_pin_worker(runner_worker_t *worker) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) { return; }
+    int cpus = CPU_COUNT(&allowed);
+    if (cpus <= 1) { return; }
+
+    // The Nth allowed core, wrapping round when there are more workers than cores
+    int nth = (int)(worker->index % (uint32_t)cpus);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed) && nth-- == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            return;
+        }
+    }
+#else
+    (void)worker;
+#endif
+}
+
+/*
+ * Wait until every worker reaches the barrier, i.e. has finished the current frame.
+ */
+static
+void session_runner_barrier_wait(session_runner_t *runner) {
+    SDL_LockMutex(runner->lock);
+    uint32_t generation = runner->barrier_generation;
+    runner->barrier_waiting += 1;
+    if (runner->barrier_waiting == runner->worker_count) {
+        runner->barrier_waiting = 0;
+        runner->barrier_generation += 1;
+        SDL_CondBroadcast(runner->barrier);
+    } else {
+        while (generation == runner->barrier_generation) {
+            SDL_CondWait(runner->barrier, runner->lock);
+        }
+    }
+    SDL_UnlockMutex(runner->lock);
+}
+
+static
+double runner_seconds(void) {
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#define TEST_SESSIONS   256
+
+typedef struct {
+    SDL_atomic_t frames[TEST_SESSIONS];
+    SDL_atomic_t out_of_step;
+    bool check_lockstep;
+} test_context_t;
+
+// A stand-in game: scroll some noise and print the frame number
+static void test_step(runner_session_t *session, void *context) {
+    test_context_t *test = context;
+    console_screen_t *screen = session->screen;
+    uint32_t *seed = session->state;
+
+    if (test->check_lockstep) {
+        // No session may be a whole frame ahead of or behind this one
+        int own = (int)session->frame;
+        for (uint32_t i = 0; i < TEST_SESSIONS; i += 17) {
+            int other = SDL_AtomicGet(&test->frames[i]);
+            if (other < own || other > own + 1) {
+                SDL_AtomicAdd(&test->out_of_step, 1);
+            }
+        }
+    }
+
+    console_screen_clear(screen);
+    for (uint32_t i = 0; i < 200; i++) {
+        *seed = (*seed * 1103515245) + 12345;
+        console_screen_set_cell(screen, (*seed >> 8) % screen->width, (*seed >> 20) % screen->height,
+                (console_cell_t){ '*', 0xffffffff, 0 });
+    }
+    console_screen_printf_at(screen, (console_rect_t){0, 0, 20, 1}, 0xffffffff, 0, "frame %llu",
+            (unsigned long long)session->frame);
+
+    SDL_AtomicSet(&test->frames[session->index], (int)session->frame + 1);
+}
+
+int main() {
+    test_context_t *test = calloc(1, sizeof(test_context_t));
+    session_runner_t *runner = session_runner_create(TEST_SESSIONS, 80, 25, 0, test_step, test);
+    uint32_t *seeds = calloc(TEST_SESSIONS, sizeof(uint32_t));
+    for (uint32_t i = 0; i < TEST_SESSIONS; i++) {
+        seeds[i] = i;
+        session_runner_session(runner, i)->state = &seeds[i];
+    }
+
+    test->check_lockstep = true;
+    session_runner_run(runner, SESSION_RUNNER_LOCKSTEP, 100);
+    runner_stats_t lockstep = session_runner_stats(runner);
+    printf("Lockstep: %u sessions on %u threads, %.0f frames/s, out of step %d\n", TEST_SESSIONS,
+            runner->worker_count, lockstep.frames_per_second, SDL_AtomicGet(&test->out_of_step));
+
+    test->check_lockstep = false;
+    session_runner_run(runner, SESSION_RUNNER_FREE, 1000);
+    runner_stats_t total = session_runner_stats(runner);
+    double free_fps = (total.frames - lockstep.frames) / (total.seconds - lockstep.seconds);
+    printf("Free: %.0f frames/s\n", free_fps);
+
+    bool all_done = true;
+    for (uint32_t i = 0; i < TEST_SESSIONS; i++) {
+        all_done = all_done && session_runner_session(runner, i)->frame == 1100;
+    }
+    printf("Every session stepped 1100 frames: %s\n", all_done ? "yes" : "NO");
+
+    bool in_step = SDL_AtomicGet(&test->out_of_step) == 0;
+    session_runner_destroy(runner);
+    free(seeds);
+    free(test);
+
+    return (all_done && in_step) ? 0 : 1;
+}
+
+#endif
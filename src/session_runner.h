@@ -0,0 +1,122 @@
+#ifndef SESSION_RUNNER_H
+#define SESSION_RUNNER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+#include "console.h"
+
+
+/*
+ * Session runner - many headless game sessions stepped in parallel, for bots and tests.
+ *
+ * Each session is a screen plus caller state, with no window, renderer or SDL video at
+ * all. The caller's step function advances one session by one frame, drawing into its
+ * screen. Sessions are split into contiguous blocks across a pool of worker threads; on
+ * Linux each worker is pinned to its own core so a session's data stays in one cache.
+ *
+ * In lockstep mode every session finishes frame N before any session starts frame N + 1,
+ * e.g. for bots that see each other. In free mode each worker runs its sessions straight
+ * through with no synchronisation at all.
+ *
+ * The step function is called concurrently for different sessions and must only touch
+ * its own session (and anything it synchronises itself).
+ *
+ *  Example usage:
+ *      session_runner_t *runner = session_runner_create(1000, 80, 25, 0, bot_step, NULL);
+ *      for (uint32_t i = 0; i < 1000; i++) {
+ *          session_runner_session(runner, i)->state = bot_create(i);
+ *      }
+ *      session_runner_run(runner, SESSION_RUNNER_FREE, 10000);
+ *      printf("%.0f frames/s\n", session_runner_stats(runner).frames_per_second);
+ */
+
+
+/** Type definitions **/
+
+typedef struct {
+    uint32_t index;
+    uint64_t frame;             // frames this session has completed
+    console_screen_t *screen;
+    void *state;                // the caller's, never touched by the runner
+} runner_session_t;
+
+typedef void (*runner_step_fn)(runner_session_t *session, void *context);
+
+typedef enum {
+    SESSION_RUNNER_LOCKSTEP,
+    SESSION_RUNNER_FREE
+} runner_mode_t;
+
+typedef struct {
+    uint64_t frames;            // session frames stepped, across all sessions and runs
+    double seconds;             // wall time spent in session_runner_run
+    double frames_per_second;
+} runner_stats_t;
+
+typedef struct session_runner_s session_runner_t;
+
+typedef struct {
+    session_runner_t *runner;
+    uint32_t index;
+    uint32_t first_session;
+    uint32_t session_count;
+    SDL_Thread *thread;
+} runner_worker_t;
+
+struct session_runner_s {
+    uint32_t session_count;
+    runner_session_t *sessions;
+    uint32_t worker_count;
+    runner_worker_t *workers;
+    runner_step_fn step;
+    void *context;
+
+    SDL_mutex *lock;
+    SDL_cond *start;            // workers wait here for a run
+    SDL_cond *finish;           // the caller waits here for the workers
+    uint32_t run_generation;    // bumped to start a run
+    uint32_t finished;          // workers done with the current run
+    bool running;
+
+    // The current run; set before run_generation changes
+    runner_mode_t mode;
+    uint64_t frame_count;
+
+    // Lockstep barrier
+    SDL_cond *barrier;
+    uint32_t barrier_waiting;
+    uint32_t barrier_generation;
+
+    runner_stats_t stats;
+};
+// Should only use the runner via functions, not direct property access
+
+
+/** Public Interface **/
+
+/**
+ *  Create session_count sessions, each with a width x height screen, and a pool of
+ *  thread_count workers (0 for one per CPU core, never more than there are sessions).
+ *  Returns NULL if a worker thread can't be started.
+ */
+session_runner_t * session_runner_create(uint32_t session_count, uint32_t width, uint32_t height,
+        uint32_t thread_count, runner_step_fn step, void *context);
+
+/**
+ *  Stop the workers and destroy the sessions' screens. Session state is the caller's to free.
+ */
+void session_runner_destroy(session_runner_t *runner);
+
+runner_session_t * session_runner_session(session_runner_t *runner, uint32_t index);
+
+/**
+ *  Step every session frame_count frames and return once all are done.
+ */
+void session_runner_run(session_runner_t *runner, runner_mode_t mode, uint64_t frame_count);
+
+runner_stats_t session_runner_stats(const session_runner_t *runner);
+
+
+#endif
@@ -0,0 +1,173 @@
+
+
+#include "view_file.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+#define VIEW_FILE_BYTE_ORDER    0x01020304
+
+_Static_assert(sizeof(view_file_header_t) <= VIEW_FILE_CELLS_OFFSET, "view file header must fit before the cells");
+
+
+// External Interface --
+
+bool view_file_save(const console_view_t *view, const char *filename) {
+    // Loaded views map their file, so never rewrite it in place: write a temporary file
+    // next to it and rename that over it, leaving existing mappings on the old file
+    size_t name_length = strlen(filename);
+    char *temp_filename = malloc(name_length + sizeof(".XXXXXX"));
+    if (!temp_filename) {
+        return false;
+    }
+    memcpy(temp_filename, filename, name_length);
+    strcpy(temp_filename + name_length, ".XXXXXX");
+
+    int fd = mkstemp(temp_filename);
+    if (fd < 0) {
+        free(temp_filename);
+        return false;
+    }
+    fchmod(fd, 0644);   // mkstemp creates the file private to the user
+    FILE *file = fdopen(fd, "wb");
+    if (!file) {
+        close(fd);
+        remove(temp_filename);
+        free(temp_filename);
+        return false;
+    }
+
+    uint8_t header_block[VIEW_FILE_CELLS_OFFSET] = {0};
+    view_file_header_t header = {
+        .version = VIEW_FILE_VERSION,
+        .byte_order = VIEW_FILE_BYTE_ORDER,
+        .cell_size = sizeof(console_cell_t),
+        .width = view->width,
+        .height = view->height,
+        .cells_offset = VIEW_FILE_CELLS_OFFSET,
+    };
+    memcpy(header.magic, VIEW_FILE_MAGIC, sizeof(header.magic));
+    memcpy(header_block, &header, sizeof(header));
+
+    size_t cell_count = (size_t)view->width * view->height;
+    bool ok = (fwrite(header_block, 1, sizeof(header_block), file) == sizeof(header_block)) &&
+              (fwrite(view->cells, sizeof(console_cell_t), cell_count, file) == cell_count);
+
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+    if (ok && rename(temp_filename, filename) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        remove(temp_filename);
+    }
+    free(temp_filename);
+
+    return ok;
+}
+
+console_view_t * view_file_load(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < VIEW_FILE_CELLS_OFFSET) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Validate the header before trusting any of its dimensions. The cell count is bounded
+    // by division, as width * height * cell size can wrap round to something small
+    const view_file_header_t *header = mapping;
+    if (memcmp(header->magic, VIEW_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != VIEW_FILE_VERSION ||
+        header->byte_order != VIEW_FILE_BYTE_ORDER ||
+        header->cell_size != sizeof(console_cell_t) ||
+        header->cells_offset < sizeof(view_file_header_t) ||
+        (header->cells_offset % sizeof(uint32_t)) != 0 ||
+        header->cells_offset > size ||
+        header->width == 0 || header->height == 0 ||
+        header->height > (size - header->cells_offset) / sizeof(console_cell_t) / header->width) {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    console_view_t *view = calloc(1, sizeof(console_view_t));
+    view->width = header->width;
+    view->height = header->height;
+    view->cells = (console_cell_t *)((uint8_t *)mapping + header->cells_offset);
+    view->mapping = mapping;
+    view->mapping_size = size;
+
+    return view;
+}
+
+
+
+/* Test Harness - define __TEST__ to test */
+
+#ifdef __TEST__
+
+#define TEST_VIEW_FILE  "/tmp/view_file_test.view"
+
+// Save a small view, then overwrite its header's dimensions and try to load it
+static bool load_with_dimensions(uint32_t width, uint32_t height) {
+    console_cell_t cells[6] = {{0}};
+    console_view_t view = { .width = 3, .height = 2, .cells = cells };
+    view_file_save(&view, TEST_VIEW_FILE);
+
+    FILE *file = fopen(TEST_VIEW_FILE, "r+b");
+    fseek(file, offsetof(view_file_header_t, width), SEEK_SET);
+    fwrite(&width, sizeof(width), 1, file);
+    fwrite(&height, sizeof(height), 1, file);
+    fclose(file);
+
+    console_view_t *loaded = view_file_load(TEST_VIEW_FILE);
+    if (loaded == NULL) {
+        return false;
+    }
+    console_view_destroy(loaded);
+    return true;
+}
+
+int main() {
+    bool valid_ok = load_with_dimensions(3, 2);
+
+    // The loaded cells are read-only pages, so writes through the view API are refused
+    console_view_t *mapped = view_file_load(TEST_VIEW_FILE);
+    bool write_refused = mapped != NULL && !console_view_set_cell(mapped, 0, 0, (console_cell_t){ '@', 0, 0 });
+    if (mapped != NULL) {
+        console_view_destroy(mapped);
+    }
+
+    // 0x80000000 squared times the cell size wraps to 0, which once passed the size check
+    bool wrap_rejected = !load_with_dimensions(0x80000000, 0x80000000);
+    bool too_tall_rejected = !load_with_dimensions(3, 3);
+    bool empty_rejected = !load_with_dimensions(0, 2);
+
+    printf("Valid view file loads: %s, writing its cells refused: %s\n", valid_ok ? "yes" : "NO",
+            write_refused ? "yes" : "NO");
+    printf("Wrapping dimensions rejected: %s, too many rows rejected: %s, zero width rejected: %s\n",
+            wrap_rejected ? "yes" : "NO", too_tall_rejected ? "yes" : "NO", empty_rejected ? "yes" : "NO");
+    remove(TEST_VIEW_FILE);
+
+    return (valid_ok && write_refused && wrap_rejected && too_tall_rejected && empty_rejected) ? 0 : 1;
+}
+
+#endif
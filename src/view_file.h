@@ -0,0 +1,56 @@
+#ifndef VIEW_FILE_H
+#define VIEW_FILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "console.h"
+
+
+/*
+ * Precompiled view files - console views stored ready to use.
+ *
+ * A view file holds already flattened, row-major console_cell_t data behind a small
+ * header, aligned so the file can be memory-mapped and its cells used in place.
+ * Loading one is an open + mmap: nothing is decoded or copied, and the read-only
+ * pages are shared by every process that maps the same file.
+ *
+ * Files are written in the host's native byte order and console_cell_t layout;
+ * the header records both so a mismatched file is rejected rather than misread.
+ * Use tools/xp2view to convert REXPaint files.
+ */
+
+
+#define VIEW_FILE_MAGIC         "CVEW"
+#define VIEW_FILE_VERSION       1
+#define VIEW_FILE_CELLS_OFFSET  64      // cell data starts one cache line into the file
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;    // 0x01020304 as written by the host that created the file
+    uint32_t cell_size;     // sizeof(console_cell_t)
+    uint32_t width;
+    uint32_t height;
+    uint32_t cells_offset;
+    uint32_t reserved;
+} view_file_header_t;
+
+
+/**
+ *  Write the given view to a view file. Returns false if the file can't be written.
+ *  The file is replaced with a rename, so views already mapped from it are unaffected.
+ */
+bool view_file_save(const console_view_t *view, const char *filename);
+
+/**
+ *  Map the given view file and return a view whose cells point directly into the mapping.
+ *  The cells are read-only: writing to them will fault. Destroy the view with
+ *  console_view_destroy, which unmaps the file.
+ *  Returns NULL if the file can't be mapped or isn't a valid view file.
+ */
+console_view_t * view_file_load(const char *filename);
+
+
+#endif
+
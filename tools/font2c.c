@@ -0,0 +1,255 @@
+/*
+ * font2c - convert a font atlas image into a 1-bit bitmap compiled into the engine.
+ *
+ * Usage: font2c [-n name] [-s glyph_width glyph_height] atlas.png > output.c
+ *
+ * The atlas is a grid of equally sized glyphs (10x16 by default), glyph 0 at the top left,
+ * running left to right then top to bottom. Every pixel brighter than mid grey (and, for
+ * images with alpha, more than half opaque) is set. The generated file defines an
+ * embedded_font_t (see src/embedded_font.h) named console_embedded_font unless -n is given.
+ *
+ * Only what font atlases need from PNG is supported: 8-bit greyscale, RGB or RGBA,
+ * optionally with alpha, not interlaced. Needs nothing but zlib, so it can run as a build
+ * step before anything else is compiled.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../lib/zlib.h"
+
+
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint8_t *pixels;        // width * height * channels, row-major
+} image_t;
+
+
+static uint32_t read_be32(const uint8_t *bytes) {
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | bytes[3];
+}
+
+static uint8_t * read_file(const char *filename, size_t *size) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (len <= 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    uint8_t *data = malloc((size_t)len);
+    if (fread(data, 1, (size_t)len, f) != (size_t)len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+
+    *size = (size_t)len;
+    return data;
+}
+
+static uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int p = (int)a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) { return a; }
+    return (pb <= pc) ? b : c;
+}
+
+/*
+ * Undo the per-row PNG filters in place, leaving the filter bytes where they are.
+ */
+static bool unfilter(uint8_t *data, uint32_t width, uint32_t height, uint32_t channels) {
+    size_t stride = (size_t)width * channels;
+    for (uint32_t y = 0; y < height; y++) {
+        uint8_t *row = &data[y * (stride + 1)];
+        uint8_t filter = row[0];
+        uint8_t *line = row + 1;
+        const uint8_t *prev = (y > 0) ? line - (stride + 1) : NULL;
+
+        for (size_t x = 0; x < stride; x++) {
+            uint8_t a = (x >= channels) ? line[x - channels] : 0;
+            uint8_t b = prev ? prev[x] : 0;
+            uint8_t c = (prev && x >= channels) ? prev[x - channels] : 0;
+            switch (filter) {
+                case 0: break;
+                case 1: line[x] += a; break;
+                case 2: line[x] += b; break;
+                case 3: line[x] += (uint8_t)(((uint32_t)a + b) / 2); break;
+                case 4: line[x] += paeth(a, b, c); break;
+                default: return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool load_png(const char *filename, image_t *image) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+    size_t size;
+    uint8_t *data = read_file(filename, &size);
+    if (!data) {
+        fprintf(stderr, "font2c: unable to read %s\n", filename);
+        return false;
+    }
+    if (size < 8 || memcmp(data, signature, 8) != 0) {
+        fprintf(stderr, "font2c: %s is not a PNG file\n", filename);
+        free(data);
+        return false;
+    }
+
+    // Gather the header and the concatenated IDAT chunks
+    uint8_t *compressed = malloc(size);
+    size_t compressed_size = 0;
+    bool have_header = false;
+    uint32_t bit_depth = 0, color_type = 0, interlace = 0;
+    for (size_t pos = 8; pos + 12 <= size; ) {
+        uint32_t length = read_be32(&data[pos]);
+        const uint8_t *type = &data[pos + 4];
+        const uint8_t *chunk = &data[pos + 8];
+        if (length > size - pos - 12) {
+            break;
+        }
+
+        if (memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+            image->width = read_be32(chunk);
+            image->height = read_be32(chunk + 4);
+            bit_depth = chunk[8];
+            color_type = chunk[9];
+            interlace = chunk[12];
+            have_header = true;
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            memcpy(&compressed[compressed_size], chunk, length);
+            compressed_size += length;
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        pos += 12 + (size_t)length;
+    }
+    free(data);
+
+    switch (color_type) {
+        case 0: image->channels = 1; break;     // greyscale
+        case 2: image->channels = 3; break;     // RGB
+        case 4: image->channels = 2; break;     // greyscale + alpha
+        case 6: image->channels = 4; break;     // RGBA
+        default: image->channels = 0; break;
+    }
+    if (!have_header || bit_depth != 8 || image->channels == 0 || interlace != 0 ||
+        image->width == 0 || image->height == 0 || image->width > 16384 || image->height > 16384) {
+        fprintf(stderr, "font2c: %s: only non-interlaced 8-bit greyscale/RGB(A) images are supported\n", filename);
+        free(compressed);
+        return false;
+    }
+
+    // Each row is preceded by a filter type byte
+    size_t stride = (size_t)image->width * image->channels;
+    uLongf raw_size = (uLongf)((stride + 1) * image->height);
+    uint8_t *raw = malloc(raw_size);
+    uLongf expected = raw_size;
+    bool ok = uncompress(raw, &raw_size, compressed, (uLong)compressed_size) == Z_OK && raw_size == expected &&
+              unfilter(raw, image->width, image->height, image->channels);
+    free(compressed);
+    if (!ok) {
+        fprintf(stderr, "font2c: %s: corrupt image data\n", filename);
+        free(raw);
+        return false;
+    }
+
+    image->pixels = malloc(stride * image->height);
+    for (uint32_t y = 0; y < image->height; y++) {
+        memcpy(&image->pixels[y * stride], &raw[(y * (stride + 1)) + 1], stride);
+    }
+    free(raw);
+
+    return true;
+}
+
+static bool pixel_is_set(const image_t *image, uint32_t x, uint32_t y) {
+    const uint8_t *p = &image->pixels[(((size_t)y * image->width) + x) * image->channels];
+    switch (image->channels) {
+        case 1: return p[0] >= 128;
+        case 2: return p[0] >= 128 && p[1] >= 128;
+        case 3: return ((uint32_t)p[0] + p[1] + p[2]) >= 3 * 128;
+        default: return ((uint32_t)p[0] + p[1] + p[2]) >= 3 * 128 && p[3] >= 128;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = "console_embedded_font";
+    uint32_t glyph_width = 10, glyph_height = 16;
+
+    int arg = 1;
+    while (arg < argc - 1 && argv[arg][0] == '-') {
+        if (strcmp(argv[arg], "-n") == 0) {
+            name = argv[arg + 1];
+            arg += 2;
+        } else if (strcmp(argv[arg], "-s") == 0 && arg + 2 < argc - 1) {
+            glyph_width = (uint32_t)atoi(argv[arg + 1]);
+            glyph_height = (uint32_t)atoi(argv[arg + 2]);
+            arg += 3;
+        } else {
+            break;
+        }
+    }
+    if (arg != argc - 1 || glyph_width == 0 || glyph_height == 0) {
+        fprintf(stderr, "usage: %s [-n name] [-s glyph_width glyph_height] atlas.png > output.c\n", argv[0]);
+        return 1;
+    }
+    const char *input = argv[arg];
+
+    image_t image = {0};
+    if (!load_png(input, &image)) {
+        return 1;
+    }
+    if (image.width % glyph_width != 0 || image.height % glyph_height != 0) {
+        fprintf(stderr, "font2c: %s is %ux%u, not a whole number of %ux%u glyphs\n",
+                input, image.width, image.height, glyph_width, glyph_height);
+        free(image.pixels);
+        return 1;
+    }
+
+    // Rows of the atlas, one bit per pixel, most significant bit first
+    uint32_t row_bytes = (image.width + 7) / 8;
+    printf("/*\n * Generated by tools/font2c from %s - do not edit.\n */\n\n", input);
+    printf("#include \"embedded_font.h\"\n\n\n");
+    printf("static const uint8_t %s_bits[%u] = {\n", name, row_bytes * image.height);
+    for (uint32_t y = 0; y < image.height; y++) {
+        printf("   ");
+        for (uint32_t b = 0; b < row_bytes; b++) {
+            uint8_t byte = 0;
+            for (uint32_t bit = 0; bit < 8; bit++) {
+                uint32_t x = (b * 8) + bit;
+                if (x < image.width && pixel_is_set(&image, x, y)) {
+                    byte |= (uint8_t)(0x80 >> bit);
+                }
+            }
+            printf(" 0x%02x,", byte);
+        }
+        printf("\n");
+    }
+    printf("};\n\n");
+
+    printf("const embedded_font_t %s = {\n", name);
+    printf("    .glyph_width = %u,\n", glyph_width);
+    printf("    .glyph_height = %u,\n", glyph_height);
+    printf("    .columns = %u,\n", image.width / glyph_width);
+    printf("    .glyph_count = %u,\n", (image.width / glyph_width) * (image.height / glyph_height));
+    printf("    .atlas_width = %u,\n", image.width);
+    printf("    .atlas_height = %u,\n", image.height);
+    printf("    .row_bytes = %u,\n", row_bytes);
+    printf("    .bits = %s_bits,\n", name);
+    printf("};\n");
+
+    free(image.pixels);
+    return 0;
+}
@@ -0,0 +1,146 @@
+
+
+/*
+ * pack - build an asset archive from a list of files.
+ *
+ * Usage: pack output.pak file [file ...]
+ *
+ * Each file is stored under the path given on the command line (e.g. "assets/cat.xp"),
+ * which is the name to look it up by with archive_find. Files are stored unmodified;
+ * gzip-compressed files (such as REXPaint .xp files) are marked as such in the index.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/archive.h"
+
+
+typedef struct {
+    const char *name;
+    uint8_t *data;
+    uint64_t size;
+} pack_file_t;
+
+
+static int compare_files(const void *a, const void *b) {
+    return strcmp(((const pack_file_t *)a)->name, ((const pack_file_t *)b)->name);
+}
+
+static uint8_t * read_file(const char *filename, uint64_t *size) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (len < 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    uint8_t *data = malloc(len > 0 ? (size_t)len : 1);
+    if (fread(data, 1, (size_t)len, f) != (size_t)len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+
+    *size = (uint64_t)len;
+    return data;
+}
+
+static uint64_t align(uint64_t offset) {
+    return (offset + ARCHIVE_DATA_ALIGNMENT - 1) & ~(uint64_t)(ARCHIVE_DATA_ALIGNMENT - 1);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s output.pak file [file ...]\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t count = (uint32_t)(argc - 2);
+    pack_file_t *files = calloc(count, sizeof(pack_file_t));
+    for (uint32_t i = 0; i < count; i++) {
+        files[i].name = argv[i + 2];
+        files[i].data = read_file(files[i].name, &files[i].size);
+        if (!files[i].data) {
+            fprintf(stderr, "pack: unable to read %s\n", files[i].name);
+            return 1;
+        }
+    }
+
+    // The index is sorted by name so the engine can binary search it in place
+    qsort(files, count, sizeof(pack_file_t), compare_files);
+    for (uint32_t i = 1; i < count; i++) {
+        if (strcmp(files[i - 1].name, files[i].name) == 0) {
+            fprintf(stderr, "pack: %s given more than once\n", files[i].name);
+            return 1;
+        }
+    }
+
+    archive_header_t header = {
+        .version = ARCHIVE_VERSION,
+        .byte_order = 0x01020304,
+        .entry_count = count,
+        .names_offset = sizeof(archive_header_t) + (uint64_t)count * sizeof(archive_entry_t),
+    };
+    memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+
+    archive_entry_t *entries = calloc(count, sizeof(archive_entry_t));
+    for (uint32_t i = 0; i < count; i++) {
+        entries[i].name_offset = (uint32_t)header.names_size;
+        entries[i].name_length = (uint32_t)strlen(files[i].name);
+        header.names_size += entries[i].name_length;
+    }
+
+    uint64_t offset = align(header.names_offset + header.names_size);
+    for (uint32_t i = 0; i < count; i++) {
+        bool gzip = files[i].size >= 2 && files[i].data[0] == 0x1f && files[i].data[1] == 0x8b;
+        entries[i].data_offset = offset;
+        entries[i].size = files[i].size;
+        entries[i].compression = gzip ? ARCHIVE_COMPRESSION_GZIP : ARCHIVE_COMPRESSION_NONE;
+        offset = align(offset + files[i].size);
+    }
+
+    FILE *out = fopen(argv[1], "wb");
+    if (!out) {
+        fprintf(stderr, "pack: unable to write %s\n", argv[1]);
+        return 1;
+    }
+
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(entries, sizeof(archive_entry_t), count, out);
+    for (uint32_t i = 0; i < count; i++) {
+        fwrite(files[i].name, 1, entries[i].name_length, out);
+    }
+
+    static const uint8_t padding[ARCHIVE_DATA_ALIGNMENT] = {0};
+    uint64_t written = header.names_offset + header.names_size;
+    for (uint32_t i = 0; i < count; i++) {
+        fwrite(padding, 1, entries[i].data_offset - written, out);
+        fwrite(files[i].data, 1, files[i].size, out);
+        written = entries[i].data_offset + files[i].size;
+        printf("%-40s %10llu bytes%s\n", files[i].name, (unsigned long long)files[i].size,
+                (entries[i].compression == ARCHIVE_COMPRESSION_GZIP) ? " (gzip)" : "");
+        free(files[i].data);
+    }
+
+    bool ok = (ferror(out) == 0);
+    if (fclose(out) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        fprintf(stderr, "pack: error writing %s\n", argv[1]);
+        remove(argv[1]);
+    }
+
+    free(entries);
+    free(files);
+
+    return ok ? 0 : 1;
+}
+
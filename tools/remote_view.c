@@ -0,0 +1,98 @@
+/*
+ * remote_view - watch a running game through its remote console server.
+ *
+ * Usage: remote_view socket_path
+ *
+ * Opens a window sized to the remote screen once the first keyframe arrives and redraws
+ * it whenever the screen changes. Closing the window only disconnects this viewer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+#include "../src/console.h"
+#include "../src/embedded_font.h"
+#include "../src/remote_console.h"
+
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s socket_path\n", argv[0]);
+        return 1;
+    }
+
+    remote_client_t *client = remote_client_connect(argv[1]);
+    if (client == NULL) {
+        fprintf(stderr, "remote_view: no server at %s\n", argv[1]);
+        return 1;
+    }
+
+    SDL_Init(SDL_INIT_VIDEO);
+    SDL_Window *window = NULL;
+    console_t *console = NULL;
+    uint32_t console_cols = 0;
+    uint32_t console_rows = 0;
+
+    int status = 0;
+    bool running = true;
+    while (running) {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) {
+                running = false;
+            }
+        }
+
+        int32_t applied = remote_client_update(client, 15);
+        if (applied < 0) {
+            fprintf(stderr, "remote_view: disconnected\n");
+            break;
+        }
+        console_screen_t *screen = remote_client_screen(client);
+        if (applied == 0 || screen == NULL) {
+            continue;
+        }
+
+        // (Re)open the window whenever the remote screen changes size
+        if (console == NULL || console_cols != screen->width || console_rows != screen->height) {
+            if (console != NULL) {
+                console_destroy(console);
+                SDL_DestroyWindow(window);
+                console = NULL;
+            }
+            uint32_t width = screen->width * console_embedded_font.glyph_width;
+            uint32_t height = screen->height * console_embedded_font.glyph_height;
+            window = SDL_CreateWindow(argv[1], SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                    (int)width, (int)height, 0);
+            if (window == NULL) {
+                fprintf(stderr, "remote_view: unable to open a window: %s\n", SDL_GetError());
+                status = 1;
+                break;
+            }
+            console = console_create_with_embedded_font(window, width, height, screen->height, screen->width, screen->bg_color);
+            if (console == NULL) {
+                fprintf(stderr, "remote_view: unable to create a console: %s\n", SDL_GetError());
+                SDL_DestroyWindow(window);
+                status = 1;
+                break;
+            }
+            console_cols = screen->width;
+            console_rows = screen->height;
+        }
+
+        console->bg_color = screen->bg_color;
+        console_clear(console);
+        console_render_screen(console, screen);
+    }
+
+    if (console != NULL) {
+        console_destroy(console);
+        SDL_DestroyWindow(window);
+    }
+    remote_client_destroy(client);
+    SDL_Quit();
+
+    return status;
+}
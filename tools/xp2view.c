@@ -0,0 +1,71 @@
+
+
+/*
+ * xp2view - convert REXPaint .xp files into precompiled view files.
+ *
+ * Usage: xp2view input.xp [input2.xp ...]
+ *        xp2view -o output.view input.xp
+ *
+ * Without -o, each input is written next to itself with its extension replaced by ".view".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/console.h"
+#include "../src/rex_loader.h"
+#include "../src/view_file.h"
+
+
+static bool convert(const char *input, const char *output) {
+    console_view_t *view = console_view_from_rexfile(input);
+    if (!view) {
+        fprintf(stderr, "xp2view: %s\n", rex_get_error());
+        return false;
+    }
+
+    bool ok = view_file_save(view, output);
+    if (ok) {
+        printf("%s -> %s (%ux%u)\n", input, output, view->width, view->height);
+    } else {
+        fprintf(stderr, "xp2view: unable to write %s\n", output);
+    }
+
+    console_view_destroy(view);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s [-o output.view] input.xp [input.xp ...]\n", argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "-o") == 0) {
+        if (argc != 4) {
+            fprintf(stderr, "usage: %s -o output.view input.xp\n", argv[0]);
+            return 1;
+        }
+        return convert(argv[3], argv[2]) ? 0 : 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; i++) {
+        const char *input = argv[i];
+        const char *ext = strrchr(input, '.');
+        size_t base_len = (ext != NULL && strchr(ext, '/') == NULL) ? (size_t)(ext - input) : strlen(input);
+
+        char *output = malloc(base_len + sizeof(".view"));
+        memcpy(output, input, base_len);
+        strcpy(output + base_len, ".view");
+
+        if (!convert(input, output)) {
+            failures += 1;
+        }
+        free(output);
+    }
+
+    return (failures == 0) ? 0 : 1;
+}
+